@@ -37,14 +37,19 @@
 #define MSGPACK_DISABLE_LEGACY_CONVERT
 #endif
 
+#include "wamp_dispatch.hpp"
 #include "wamp_event.hpp"
 #include "wamp_invocation.hpp"
 #include "wamp_session.hpp"
 #include "wamp_tcp_transport.hpp"
+#include "wamp_topic_trie.hpp"
 #include "wamp_transport.hpp"
 #ifdef BOOST_ASIO_HAS_LOCAL_SOCKETS
 #include "wamp_uds_transport.hpp"
 #endif
+#ifdef BOOST_ASIO_HAS_CO_AWAIT
+#include "wamp_coroutine.hpp"
+#endif
 
 /*! \mainpage Autobahn-C++ Documentation
 
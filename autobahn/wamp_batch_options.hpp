@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_BATCH_OPTIONS_HPP
+#define AUTOBAHN_WAMP_BATCH_OPTIONS_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace autobahn {
+
+/*!
+ * Options controlling how a transport coalesces outbound messages.
+ *
+ * When batching is enabled, messages are not written as soon as they are
+ * sent. Instead they are held until the next turn of the event loop, or
+ * until the configured delay has elapsed, and then go out together. A
+ * batch is flushed early once it holds at least max_bytes worth of
+ * serialized messages.
+ *
+ * Batching is disabled by default, in which case a message is written
+ * immediately unless another write is already in progress.
+ */
+class wamp_batch_options
+{
+public:
+    wamp_batch_options();
+
+    const bool& enabled() const;
+    const std::size_t& max_bytes() const;
+    const std::chrono::microseconds& max_delay() const;
+
+    void set_enabled(const bool& enabled);
+    void set_max_bytes(const std::size_t& max_bytes);
+
+    /*!
+     * Sets how long a message may be held before its batch is flushed. A
+     * delay of zero flushes on the next turn of the event loop.
+     */
+    void set_max_delay(const std::chrono::microseconds& max_delay);
+
+private:
+    bool m_enabled;
+    std::size_t m_max_bytes;
+    std::chrono::microseconds m_max_delay;
+};
+
+} // namespace autobahn
+
+#include "wamp_batch_options.ipp"
+
+#endif // AUTOBAHN_WAMP_BATCH_OPTIONS_HPP
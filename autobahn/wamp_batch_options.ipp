@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_batch_options::wamp_batch_options()
+    : m_enabled(false)
+    , m_max_bytes(64 * 1024)
+    , m_max_delay(0)
+{
+}
+
+inline const bool& wamp_batch_options::enabled() const
+{
+    return m_enabled;
+}
+
+inline const std::size_t& wamp_batch_options::max_bytes() const
+{
+    return m_max_bytes;
+}
+
+inline const std::chrono::microseconds& wamp_batch_options::max_delay() const
+{
+    return m_max_delay;
+}
+
+inline void wamp_batch_options::set_enabled(const bool& enabled)
+{
+    m_enabled = enabled;
+}
+
+inline void wamp_batch_options::set_max_bytes(const std::size_t& max_bytes)
+{
+    m_max_bytes = max_bytes;
+}
+
+inline void wamp_batch_options::set_max_delay(const std::chrono::microseconds& max_delay)
+{
+    m_max_delay = max_delay;
+}
+
+} // namespace autobahn
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_BATCH_STATISTICS_HPP
+#define AUTOBAHN_WAMP_BATCH_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace autobahn {
+
+/*!
+ * Counters describing the writes a transport has issued. Each batch is
+ * one write to the underlying connection carrying one or more messages.
+ */
+class wamp_batch_statistics
+{
+public:
+    wamp_batch_statistics();
+
+    /*!
+     * The number of batches written.
+     */
+    uint64_t batches() const;
+
+    /*!
+     * The number of messages written across all batches.
+     */
+    uint64_t messages() const;
+
+    /*!
+     * The number of serialized octets written across all batches,
+     * including any framing added by the transport.
+     */
+    uint64_t bytes() const;
+
+    /*!
+     * The largest number of messages written in a single batch.
+     */
+    std::size_t largest_batch() const;
+
+    /*!
+     * Records a batch that has been handed to the connection.
+     */
+    void record_batch(std::size_t messages, std::size_t bytes);
+
+    void reset();
+
+private:
+    uint64_t m_batches;
+    uint64_t m_messages;
+    uint64_t m_bytes;
+    std::size_t m_largest_batch;
+};
+
+} // namespace autobahn
+
+#include "wamp_batch_statistics.ipp"
+
+#endif // AUTOBAHN_WAMP_BATCH_STATISTICS_HPP
@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_batch_statistics::wamp_batch_statistics()
+    : m_batches(0)
+    , m_messages(0)
+    , m_bytes(0)
+    , m_largest_batch(0)
+{
+}
+
+inline uint64_t wamp_batch_statistics::batches() const
+{
+    return m_batches;
+}
+
+inline uint64_t wamp_batch_statistics::messages() const
+{
+    return m_messages;
+}
+
+inline uint64_t wamp_batch_statistics::bytes() const
+{
+    return m_bytes;
+}
+
+inline std::size_t wamp_batch_statistics::largest_batch() const
+{
+    return m_largest_batch;
+}
+
+inline void wamp_batch_statistics::record_batch(std::size_t messages, std::size_t bytes)
+{
+    m_batches++;
+    m_messages += messages;
+    m_bytes += bytes;
+    if (messages > m_largest_batch) {
+        m_largest_batch = messages;
+    }
+}
+
+inline void wamp_batch_statistics::reset()
+{
+    m_batches = 0;
+    m_messages = 0;
+    m_bytes = 0;
+    m_largest_batch = 0;
+}
+
+} // namespace autobahn
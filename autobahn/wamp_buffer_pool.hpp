@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_BUFFER_POOL_HPP
+#define AUTOBAHN_WAMP_BUFFER_POOL_HPP
+
+#include <boost/thread/mutex.hpp>
+#include <cstddef>
+#include <memory>
+#include <msgpack/sbuffer.hpp>
+#include <vector>
+
+namespace autobahn {
+
+class wamp_buffer_pool;
+
+/*!
+ * Deleter for buffers borrowed from a wamp_buffer_pool. The buffer is handed
+ * back to its pool, or simply freed if it does not belong to a pool or the
+ * pool no longer exists.
+ */
+class wamp_buffer_deleter
+{
+public:
+    wamp_buffer_deleter();
+
+    wamp_buffer_deleter(
+            const std::weak_ptr<wamp_buffer_pool>& pool,
+            std::size_t capacity);
+
+    void operator()(msgpack::sbuffer* buffer) const;
+
+private:
+    /*!
+     * The pool the buffer was borrowed from.
+     */
+    std::weak_ptr<wamp_buffer_pool> m_pool;
+
+    /*!
+     * The capacity the buffer had when it was borrowed.
+     */
+    std::size_t m_capacity;
+};
+
+/*!
+ * A serialization buffer which may have been borrowed from a pool.
+ */
+using wamp_buffer_ptr = std::unique_ptr<msgpack::sbuffer, wamp_buffer_deleter>;
+
+/*!
+ * A thread safe pool of serialization buffers. Buffers keep their capacity
+ * while pooled so that reusing one does not involve any reallocation. Free
+ * buffers are kept in power of two size classes, and the pool stops
+ * retaining buffers once their combined capacity reaches a configurable
+ * limit.
+ *
+ * The pool must be owned by a std::shared_ptr since borrowed buffers refer
+ * back to it.
+ */
+class wamp_buffer_pool :
+        public std::enable_shared_from_this<wamp_buffer_pool>
+{
+public:
+    /*!
+     * Constructs a buffer pool.
+     *
+     * @param max_retained_bytes The combined capacity of free buffers above
+     *                           which released buffers are freed.
+     */
+    wamp_buffer_pool(std::size_t max_retained_bytes = 4 * 1024 * 1024);
+
+    ~wamp_buffer_pool();
+
+    wamp_buffer_pool(const wamp_buffer_pool& other) = delete;
+    wamp_buffer_pool& operator=(const wamp_buffer_pool& other) = delete;
+
+    /*!
+     * Borrows an empty buffer from the pool. A new buffer is allocated if
+     * no free buffer is large enough. The buffer is returned to the pool
+     * once it is destroyed.
+     *
+     * @param size_hint The number of octets the buffer is expected to hold.
+     *
+     * @return The borrowed buffer.
+     */
+    wamp_buffer_ptr acquire(std::size_t size_hint = 0);
+
+    /*!
+     * The combined capacity of the free buffers held by the pool.
+     */
+    std::size_t retained_bytes() const;
+
+    /*!
+     * Frees all buffers held by the pool. Borrowed buffers are unaffected.
+     */
+    void clear();
+
+private:
+    friend class wamp_buffer_deleter;
+
+    void release(msgpack::sbuffer* buffer, std::size_t capacity);
+
+    static std::size_t size_class(std::size_t capacity);
+
+private:
+    /*!
+     * Free buffers are grouped into power of two size classes from 256
+     * octets up to 16 MiB, the largest message a rawsocket peer can accept.
+     * Buffers that have grown beyond that are never retained.
+     */
+    static const std::size_t min_size_class_shift = 8;
+    static const std::size_t max_size_class_shift = 24;
+    static const std::size_t num_size_classes = max_size_class_shift - min_size_class_shift + 1;
+
+    struct free_buffer
+    {
+        msgpack::sbuffer* m_buffer;
+        std::size_t m_capacity;
+    };
+
+    /*!
+     * Free buffers, indexed by size class.
+     */
+    std::vector<std::vector<free_buffer>> m_free_buffers;
+
+    /*!
+     * The combined capacity of all free buffers.
+     */
+    std::size_t m_retained_bytes;
+
+    /*!
+     * The limit on the combined capacity of free buffers.
+     */
+    std::size_t m_max_retained_bytes;
+
+    mutable boost::mutex m_lock;
+};
+
+/*!
+ * Borrows a buffer from the given pool, or allocates a standalone buffer
+ * if there is no pool to borrow from.
+ *
+ * @param pool The pool to borrow from, which may be null.
+ * @param size_hint The number of octets the buffer is expected to hold.
+ */
+wamp_buffer_ptr acquire_buffer(
+        const std::shared_ptr<wamp_buffer_pool>& pool,
+        std::size_t size_hint = 0);
+
+} // namespace autobahn
+
+#include "wamp_buffer_pool.ipp"
+
+#endif // AUTOBAHN_WAMP_BUFFER_POOL_HPP
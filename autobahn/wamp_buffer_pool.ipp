@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <boost/thread/lock_guard.hpp>
+
+namespace autobahn {
+
+inline wamp_buffer_deleter::wamp_buffer_deleter()
+    : m_pool()
+    , m_capacity(0)
+{
+}
+
+inline wamp_buffer_deleter::wamp_buffer_deleter(
+        const std::weak_ptr<wamp_buffer_pool>& pool,
+        std::size_t capacity)
+    : m_pool(pool)
+    , m_capacity(capacity)
+{
+}
+
+inline void wamp_buffer_deleter::operator()(msgpack::sbuffer* buffer) const
+{
+    auto pool = m_pool.lock();
+    if (pool) {
+        pool->release(buffer, m_capacity);
+    } else {
+        delete buffer;
+    }
+}
+
+inline wamp_buffer_pool::wamp_buffer_pool(std::size_t max_retained_bytes)
+    : m_free_buffers(num_size_classes)
+    , m_retained_bytes(0)
+    , m_max_retained_bytes(max_retained_bytes)
+    , m_lock()
+{
+}
+
+inline wamp_buffer_pool::~wamp_buffer_pool()
+{
+    clear();
+}
+
+inline wamp_buffer_ptr wamp_buffer_pool::acquire(std::size_t size_hint)
+{
+    std::size_t capacity = std::size_t(1) << min_size_class_shift;
+    while (capacity < size_hint) {
+        capacity *= 2;
+    }
+
+    std::weak_ptr<wamp_buffer_pool> weak_self = shared_from_this();
+
+    {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+        for (std::size_t index = size_class(capacity); index < m_free_buffers.size(); ++index) {
+            auto& free_buffers = m_free_buffers[index];
+            if (free_buffers.empty()) {
+                continue;
+            }
+
+            free_buffer buffer = free_buffers.back();
+            free_buffers.pop_back();
+            m_retained_bytes -= buffer.m_capacity;
+
+            buffer.m_buffer->clear();
+            return wamp_buffer_ptr(
+                    buffer.m_buffer, wamp_buffer_deleter(weak_self, buffer.m_capacity));
+        }
+    }
+
+    return wamp_buffer_ptr(
+            new msgpack::sbuffer(capacity), wamp_buffer_deleter(weak_self, capacity));
+}
+
+inline std::size_t wamp_buffer_pool::retained_bytes() const
+{
+    boost::lock_guard<boost::mutex> guard(m_lock);
+    return m_retained_bytes;
+}
+
+inline void wamp_buffer_pool::clear()
+{
+    boost::lock_guard<boost::mutex> guard(m_lock);
+    for (auto& free_buffers : m_free_buffers) {
+        for (auto& buffer : free_buffers) {
+            delete buffer.m_buffer;
+        }
+        free_buffers.clear();
+    }
+    m_retained_bytes = 0;
+}
+
+inline void wamp_buffer_pool::release(msgpack::sbuffer* buffer, std::size_t capacity)
+{
+    // An sbuffer doubles its allocation whenever it runs out of space, so
+    // the capacity it has grown to follows from what it held when borrowed.
+    while (capacity < buffer->size()) {
+        capacity *= 2;
+    }
+
+    if (capacity <= (std::size_t(1) << max_size_class_shift)) {
+        boost::lock_guard<boost::mutex> guard(m_lock);
+        if (m_retained_bytes + capacity <= m_max_retained_bytes) {
+            free_buffer entry;
+            entry.m_buffer = buffer;
+            entry.m_capacity = capacity;
+            m_free_buffers[size_class(capacity)].push_back(entry);
+            m_retained_bytes += capacity;
+            return;
+        }
+    }
+
+    delete buffer;
+}
+
+inline std::size_t wamp_buffer_pool::size_class(std::size_t capacity)
+{
+    std::size_t index = 0;
+    while (index + 1 < num_size_classes
+            && (std::size_t(1) << (min_size_class_shift + index + 1)) <= capacity) {
+        ++index;
+    }
+
+    return index;
+}
+
+inline wamp_buffer_ptr acquire_buffer(
+        const std::shared_ptr<wamp_buffer_pool>& pool,
+        std::size_t size_hint)
+{
+    if (pool) {
+        return pool->acquire(size_hint);
+    }
+
+    return wamp_buffer_ptr(new msgpack::sbuffer());
+}
+
+} // namespace autobahn
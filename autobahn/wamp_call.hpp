@@ -32,6 +32,9 @@
 #define AUTOBAHN_WAMP_CALL_HPP
 
 #include "wamp_call_result.hpp"
+#include "wamp_completion_handler.hpp"
+#include "wamp_progress_handler.hpp"
+#include "wamp_timer_wheel.hpp"
 #include "boost_config.hpp"
 
 namespace autobahn {
@@ -45,8 +48,41 @@ public:
     boost::promise<wamp_call_result>& result();
     void set_result(wamp_call_result&& value);
 
+    /*!
+     * Fails the call, through the completion handler if there is one and
+     * through the promise otherwise.
+     */
+    template <typename Exception>
+    void set_exception(const Exception& exception);
+
+    /*!
+     * Fails the call with an exception captured by std::current_exception(),
+     * keeping its type.
+     */
+    void set_exception(std::exception_ptr exception);
+
+    /*!
+     * Completes the call through the given handler instead of the promise.
+     */
+    void set_completion_handler(const wamp_completion_handler<wamp_call_result>& handler);
+
+    /*!
+     * The call's entry on the session's timeout wheel, scheduled if the
+     * call was made with a timeout.
+     */
+    wamp_timer_wheel_entry& deadline();
+
+    /*!
+     * The handler for progressive results, if the call asked for them.
+     */
+    const wamp_progress_handler& progress_handler() const;
+    void set_progress_handler(const wamp_progress_handler& handler);
+
 private:
     boost::promise<wamp_call_result> m_result;
+    wamp_completion_handler<wamp_call_result> m_completion_handler;
+    wamp_progress_handler m_progress_handler;
+    wamp_timer_wheel_entry m_deadline;
 };
 
 } // namespace autobahn
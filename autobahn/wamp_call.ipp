@@ -32,6 +32,9 @@ namespace autobahn {
 
 inline wamp_call::wamp_call()
     : m_result()
+    , m_completion_handler()
+    , m_progress_handler()
+    , m_deadline()
 {
 }
 
@@ -42,7 +45,50 @@ inline boost::promise<wamp_call_result>& wamp_call::result()
 
 inline void wamp_call::set_result(wamp_call_result&& value)
 {
-    m_result.set_value(std::move(value));
+    if (m_completion_handler) {
+        m_completion_handler(nullptr, std::move(value));
+    } else {
+        m_result.set_value(std::move(value));
+    }
+}
+
+template <typename Exception>
+inline void wamp_call::set_exception(const Exception& exception)
+{
+    if (m_completion_handler) {
+        m_completion_handler(std::make_exception_ptr(exception), wamp_call_result());
+    } else {
+        m_result.set_exception(boost::copy_exception(exception));
+    }
+}
+
+inline void wamp_call::set_exception(std::exception_ptr exception)
+{
+    if (m_completion_handler) {
+        m_completion_handler(exception, wamp_call_result());
+    } else {
+        m_result.set_exception(detail::to_boost_exception(exception));
+    }
+}
+
+inline void wamp_call::set_completion_handler(const wamp_completion_handler<wamp_call_result>& handler)
+{
+    m_completion_handler = handler;
+}
+
+inline wamp_timer_wheel_entry& wamp_call::deadline()
+{
+    return m_deadline;
+}
+
+inline const wamp_progress_handler& wamp_call::progress_handler() const
+{
+    return m_progress_handler;
+}
+
+inline void wamp_call::set_progress_handler(const wamp_progress_handler& handler)
+{
+    m_progress_handler = handler;
 }
 
 } // namespace autobahn
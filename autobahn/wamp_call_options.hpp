@@ -31,7 +31,11 @@
 #ifndef AUTOBAHN_WAMP_CALL_OPTIONS_HPP
 #define AUTOBAHN_WAMP_CALL_OPTIONS_HPP
 
+#include "wamp_cancellation_token.hpp"
+#include "wamp_progress_handler.hpp"
+
 #include <chrono>
+#include <memory>
 
 namespace autobahn {
 
@@ -47,10 +51,44 @@ public:
 
     const std::chrono::milliseconds& timeout() const;
 
+    /*!
+     * Sets the time the call may take. The timeout is passed on to the
+     * router, and the session fails the call with a timeout_error once it
+     * expires without a result.
+     */
     void set_timeout(const std::chrono::milliseconds& timeout);
 
+    /*!
+     * The token through which the call can be cancelled, or null if the
+     * call cannot be cancelled.
+     */
+    const wamp_cancellation_token* cancellation_token() const;
+
+    /*!
+     * Sets the token through which the call can be cancelled. Cancelling
+     * the token sends CANCEL to the router, which then fails the call
+     * according to the cancel mode. If the router does not support call
+     * canceling, the call is failed locally instead.
+     */
+    void set_cancellation_token(const wamp_cancellation_token& token);
+
+    /*!
+     * The handler for progressive results, which is empty unless the call
+     * asks for progressive results.
+     */
+    const wamp_progress_handler& progress_handler() const;
+
+    /*!
+     * Asks the callee for progressive results and sets the handler they
+     * are delivered to, in order, as they arrive. The future returned for
+     * the call resolves with the final result once the callee is done.
+     */
+    void set_progress_handler(const wamp_progress_handler& handler);
+
 private:
     std::chrono::milliseconds m_timeout;
+    std::unique_ptr<wamp_cancellation_token> m_cancellation_token;
+    wamp_progress_handler m_progress_handler;
 };
 
 } // namespace autobahn
@@ -36,6 +36,8 @@ namespace autobahn {
 
 inline wamp_call_options::wamp_call_options()
     : m_timeout()
+    , m_cancellation_token()
+    , m_progress_handler()
 {
 }
 
@@ -49,6 +51,26 @@ inline void wamp_call_options::set_timeout(const std::chrono::milliseconds& time
     m_timeout = timeout;
 }
 
+inline const wamp_cancellation_token* wamp_call_options::cancellation_token() const
+{
+    return m_cancellation_token.get();
+}
+
+inline void wamp_call_options::set_cancellation_token(const wamp_cancellation_token& token)
+{
+    m_cancellation_token.reset(new wamp_cancellation_token(token));
+}
+
+inline const wamp_progress_handler& wamp_call_options::progress_handler() const
+{
+    return m_progress_handler;
+}
+
+inline void wamp_call_options::set_progress_handler(const wamp_progress_handler& handler)
+{
+    m_progress_handler = handler;
+}
+
 } // namespace autobahn
 
 namespace msgpack {
@@ -82,13 +104,20 @@ struct pack<autobahn::wamp_call_options>
             msgpack::packer<Stream>& packer,
             autobahn::wamp_call_options const& options) const
     {
-        std::unordered_map<std::string, unsigned> options_map;
         const auto& timeout = options.timeout();
+        const bool receive_progress = static_cast<bool>(options.progress_handler());
+
+        packer.pack_map((timeout.count() > 0 ? 1 : 0) + (receive_progress ? 1 : 0));
         if (timeout.count() > 0) {
-            options_map["timeout"] = timeout.count();
+            packer.pack_str(7);
+            packer.pack_str_body("timeout", 7);
+            packer.pack(static_cast<unsigned>(timeout.count()));
+        }
+        if (receive_progress) {
+            packer.pack_str(16);
+            packer.pack_str_body("receive_progress", 16);
+            packer.pack_true();
         }
-
-        packer.pack(options_map);
 
         return packer;
     }
@@ -108,6 +137,10 @@ struct object_with_zone<autobahn::wamp_call_options>
             options_map["timeout"] = msgpack::object(timeout.count());
         }
 
+        if (options.progress_handler()) {
+            options_map["receive_progress"] = msgpack::object(true);
+        }
+
         object << options_map;
     }
 };
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_CANCELLATION_TOKEN_HPP
+#define AUTOBAHN_WAMP_CANCELLATION_TOKEN_HPP
+
+#include <boost/thread/mutex.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autobahn {
+
+/// How the dealer cancels a call, see the WAMP call canceling feature.
+enum class wamp_cancel_mode
+{
+    /// Fail the call right away but let the callee run to completion.
+    skip,
+
+    /// Interrupt the callee and fail the call once the callee has replied.
+    kill,
+
+    /// Interrupt the callee and fail the call right away.
+    killnowait
+};
+
+/// Convert a cancel mode to the string used on the wire.
+std::string to_string(wamp_cancel_mode mode);
+
+/*!
+ * Converts the string used on the wire to a cancel mode. Throws a
+ * protocol error for an unknown mode.
+ */
+wamp_cancel_mode to_cancel_mode(const std::string& mode);
+
+/*!
+ * A handle through which a running operation is told to stop. Copies of
+ * a token share their state, so one thread can cancel what another one
+ * is waiting on, and a single token may cancel several operations at
+ * once, such as all the calls of a fan-out query.
+ *
+ * A caller passes a token in wamp_call_options to be able to cancel the
+ * call later on. A callee is handed the token of its invocation, which is
+ * cancelled when the dealer interrupts the invocation.
+ *
+ * All member functions are thread safe.
+ */
+class wamp_cancellation_token
+{
+public:
+    using cancel_handler = std::function<void(wamp_cancel_mode)>;
+
+    /*!
+     * Constructs a token that has not been cancelled.
+     */
+    wamp_cancellation_token();
+
+    /*!
+     * Cancels the token and invokes its handlers on the calling thread.
+     * Does nothing if the token has already been cancelled.
+     *
+     * @param mode How the operation should be cancelled.
+     */
+    void cancel(wamp_cancel_mode mode = wamp_cancel_mode::kill) const;
+
+    /*!
+     * Determines whether the token has been cancelled.
+     */
+    bool is_cancelled() const;
+
+    /*!
+     * The mode the token was cancelled with. Only meaningful once the
+     * token has been cancelled.
+     */
+    wamp_cancel_mode mode() const;
+
+    /*!
+     * Adds a handler to invoke when the token is cancelled. If the token
+     * has already been cancelled, the handler is invoked right away. The
+     * handlers are kept for as long as the token is, so tokens are meant
+     * to be used for one operation or one group of operations.
+     *
+     * @param handler The handler to invoke.
+     */
+    void on_cancel(const cancel_handler& handler) const;
+
+private:
+    struct state
+    {
+        state();
+
+        boost::mutex m_lock;
+        bool m_cancelled;
+        wamp_cancel_mode m_mode;
+        std::vector<cancel_handler> m_handlers;
+    };
+
+    std::shared_ptr<state> m_state;
+};
+
+} // namespace autobahn
+
+#include "wamp_cancellation_token.ipp"
+
+#endif // AUTOBAHN_WAMP_CANCELLATION_TOKEN_HPP
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+
+#include <boost/thread/lock_guard.hpp>
+
+#include <utility>
+
+namespace autobahn {
+
+inline std::string to_string(wamp_cancel_mode mode)
+{
+    switch (mode) {
+        case wamp_cancel_mode::skip:
+            return "skip";
+        case wamp_cancel_mode::kill:
+            return "kill";
+        case wamp_cancel_mode::killnowait:
+            return "killnowait";
+    }
+
+    return "kill";
+}
+
+inline wamp_cancel_mode to_cancel_mode(const std::string& mode)
+{
+    if (mode == "skip") {
+        return wamp_cancel_mode::skip;
+    }
+    if (mode == "kill") {
+        return wamp_cancel_mode::kill;
+    }
+    if (mode == "killnowait") {
+        return wamp_cancel_mode::killnowait;
+    }
+
+    throw protocol_error("invalid cancel mode: " + mode);
+}
+
+inline wamp_cancellation_token::state::state()
+    : m_lock()
+    , m_cancelled(false)
+    , m_mode(wamp_cancel_mode::kill)
+    , m_handlers()
+{
+}
+
+inline wamp_cancellation_token::wamp_cancellation_token()
+    : m_state(std::make_shared<state>())
+{
+}
+
+inline void wamp_cancellation_token::cancel(wamp_cancel_mode mode) const
+{
+    std::vector<cancel_handler> handlers;
+    {
+        boost::lock_guard<boost::mutex> guard(m_state->m_lock);
+        if (m_state->m_cancelled) {
+            return;
+        }
+
+        m_state->m_cancelled = true;
+        m_state->m_mode = mode;
+        std::swap(handlers, m_state->m_handlers);
+    }
+
+    // Handlers run without the lock held so that they are free to use
+    // the token themselves.
+    for (const auto& handler : handlers) {
+        handler(mode);
+    }
+}
+
+inline bool wamp_cancellation_token::is_cancelled() const
+{
+    boost::lock_guard<boost::mutex> guard(m_state->m_lock);
+    return m_state->m_cancelled;
+}
+
+inline wamp_cancel_mode wamp_cancellation_token::mode() const
+{
+    boost::lock_guard<boost::mutex> guard(m_state->m_lock);
+    return m_state->m_mode;
+}
+
+inline void wamp_cancellation_token::on_cancel(const cancel_handler& handler) const
+{
+    wamp_cancel_mode mode;
+    {
+        boost::lock_guard<boost::mutex> guard(m_state->m_lock);
+        if (!m_state->m_cancelled) {
+            m_state->m_handlers.push_back(handler);
+            return;
+        }
+
+        mode = m_state->m_mode;
+    }
+
+    handler(mode);
+}
+
+} // namespace autobahn
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_COMPLETION_HPP
+#define AUTOBAHN_WAMP_COMPLETION_HPP
+
+#include "wamp_completion_handler.hpp"
+#include "boost_config.hpp"
+
+namespace autobahn {
+
+/*!
+ * The outcome of an asynchronous session operation. It is delivered through
+ * a completion handler if the operation was started with one, and through a
+ * promise otherwise.
+ */
+template <typename Result>
+class wamp_completion
+{
+public:
+    /*!
+     * Constructs a completion that is delivered through its promise.
+     */
+    wamp_completion();
+
+    /*!
+     * Constructs a completion that is delivered through the given handler.
+     */
+    explicit wamp_completion(const wamp_completion_handler<Result>& handler);
+
+    wamp_completion(const wamp_completion& other) = delete;
+    wamp_completion& operator=(const wamp_completion& other) = delete;
+
+    /*!
+     * The future for a completion that is delivered through its promise.
+     */
+    boost::future<Result> get_future();
+
+    void set_value(Result&& value);
+
+    template <typename Exception>
+    void set_exception(const Exception& exception);
+
+    /*!
+     * Fails the operation with an exception captured by
+     * std::current_exception(), keeping its type.
+     */
+    void set_exception(std::exception_ptr exception);
+
+private:
+    boost::promise<Result> m_promise;
+    wamp_completion_handler<Result> m_handler;
+};
+
+} // namespace autobahn
+
+#include "wamp_completion.ipp"
+
+#endif // AUTOBAHN_WAMP_COMPLETION_HPP
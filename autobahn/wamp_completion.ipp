@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <exception>
+#include <utility>
+
+namespace autobahn {
+
+template <typename Result>
+inline wamp_completion<Result>::wamp_completion()
+    : m_promise()
+    , m_handler()
+{
+}
+
+template <typename Result>
+inline wamp_completion<Result>::wamp_completion(const wamp_completion_handler<Result>& handler)
+    : m_promise()
+    , m_handler(handler)
+{
+}
+
+template <typename Result>
+inline boost::future<Result> wamp_completion<Result>::get_future()
+{
+    return m_promise.get_future();
+}
+
+template <typename Result>
+inline void wamp_completion<Result>::set_value(Result&& value)
+{
+    if (m_handler) {
+        m_handler(nullptr, std::move(value));
+    } else {
+        m_promise.set_value(std::move(value));
+    }
+}
+
+template <typename Result>
+template <typename Exception>
+inline void wamp_completion<Result>::set_exception(const Exception& exception)
+{
+    if (m_handler) {
+        m_handler(std::make_exception_ptr(exception), Result());
+    } else {
+        m_promise.set_exception(boost::copy_exception(exception));
+    }
+}
+
+template <typename Result>
+inline void wamp_completion<Result>::set_exception(std::exception_ptr exception)
+{
+    if (m_handler) {
+        m_handler(exception, Result());
+    } else {
+        m_promise.set_exception(detail::to_boost_exception(exception));
+    }
+}
+
+} // namespace autobahn
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_COMPLETION_HANDLER_HPP
+#define AUTOBAHN_WAMP_COMPLETION_HANDLER_HPP
+
+#include "boost_config.hpp"
+
+#include <boost/asio/io_service.hpp>
+#include <boost/exception_ptr.hpp>
+
+#include <exception>
+#include <functional>
+
+namespace autobahn {
+
+/*!
+ * Handler type the session completes an asynchronous operation through when
+ * it was started with a completion token rather than returning a future. The
+ * exception is null if the operation succeeded, otherwise the result is
+ * default constructed.
+ */
+template <typename Result>
+using wamp_completion_handler = std::function<void(std::exception_ptr, Result)>;
+
+/*!
+ * Adapts an asio completion handler so that the session can hold on to it.
+ * The handler is invoked on its associated executor, or on the io service if
+ * it has none, and that executor is kept busy until it has been invoked.
+ * Move-only handlers are supported.
+ *
+ * @param handler The completion handler to adapt.
+ * @param io_service The io service the session runs on.
+ *
+ * @return The handler to complete the operation through.
+ */
+template <typename Result, typename Handler>
+wamp_completion_handler<Result> make_completion_handler(
+        Handler&& handler, boost::asio::io_service& io_service);
+
+namespace detail {
+
+/*!
+ * Converts an exception captured with std::current_exception() so that it
+ * can be set on a boost::promise. The library's own exceptions keep their
+ * type, others are kept as the nearest standard exception.
+ */
+boost::exception_ptr to_boost_exception(std::exception_ptr exception);
+
+} // namespace detail
+
+} // namespace autobahn
+
+#include "wamp_completion_handler.ipp"
+
+#endif // AUTOBAHN_WAMP_COMPLETION_HANDLER_HPP
@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace autobahn {
+
+namespace detail {
+
+/// The handler along with the work keeping its executor busy.
+template <typename Handler, typename Executor>
+struct state
+{
+    state(Handler&& handler, const Executor& executor)
+        : m_handler(std::move(handler))
+        , m_work(executor)
+    {
+    }
+
+    Handler m_handler;
+    boost::asio::executor_work_guard<Executor> m_work;
+};
+
+/// Invokes the handler with the outcome once dispatched to its executor.
+template <typename Handler, typename Executor, typename Result>
+struct invocation
+{
+    void operator()()
+    {
+        m_state->m_handler(m_exception, std::move(m_result));
+        m_state->m_work.reset();
+    }
+
+    std::shared_ptr<state<Handler, Executor>> m_state;
+    std::exception_ptr m_exception;
+    Result m_result;
+};
+
+/// Copyable adapter so that the handler can be held by a std::function.
+template <typename Handler, typename Executor, typename Result>
+struct adapter
+{
+    void operator()(std::exception_ptr exception, Result result) const
+    {
+        invocation<Handler, Executor, Result> completion{
+                m_state, std::move(exception), std::move(result)};
+        boost::asio::dispatch(m_state->m_work.get_executor(), std::move(completion));
+    }
+
+    std::shared_ptr<state<Handler, Executor>> m_state;
+};
+
+inline boost::exception_ptr to_boost_exception(std::exception_ptr exception)
+{
+    // Boost can only copy exceptions whose type it knows, and otherwise
+    // falls back to the nearest standard exception. The library's own
+    // exceptions are copied explicitly so that they keep their type.
+    try {
+        std::rethrow_exception(exception);
+    } catch (const abort_error& e) {
+        return boost::copy_exception(e);
+    } catch (const network_error& e) {
+        return boost::copy_exception(e);
+    } catch (const no_session_error& e) {
+        return boost::copy_exception(e);
+    } catch (const no_transport_error& e) {
+        return boost::copy_exception(e);
+    } catch (const protocol_error& e) {
+        return boost::copy_exception(e);
+    } catch (const timeout_error& e) {
+        return boost::copy_exception(e);
+    } catch (...) {
+        return boost::current_exception();
+    }
+}
+
+} // namespace detail
+
+template <typename Result, typename Handler>
+inline wamp_completion_handler<Result> make_completion_handler(
+        Handler&& handler, boost::asio::io_service& io_service)
+{
+    typedef typename std::decay<Handler>::type handler_type;
+    typedef typename boost::asio::associated_executor<
+            handler_type, boost::asio::io_service::executor_type>::type executor_type;
+
+    handler_type local_handler(std::forward<Handler>(handler));
+    executor_type executor = boost::asio::get_associated_executor(
+            local_handler, io_service.get_executor());
+
+    detail::adapter<handler_type, executor_type, Result> result{
+            std::make_shared<detail::state<handler_type, executor_type>>(
+                    std::move(local_handler), executor)};
+
+    return result;
+}
+
+} // namespace autobahn
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_COROUTINE_HPP
+#define AUTOBAHN_WAMP_COROUTINE_HPP
+
+#include "wamp_dispatch.hpp"
+#include "wamp_invocation.hpp"
+#include "wamp_procedure.hpp"
+#include "boost_config.hpp"
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+
+#if defined(BOOST_ASIO_HAS_CO_AWAIT)
+
+namespace autobahn {
+
+/*!
+ * Adapts a coroutine so that it can be provided as a procedure.
+ *
+ * The coroutine takes the wamp_invocation and returns a boost::asio::awaitable.
+ * It is spawned on the given executor for every invocation. Whatever it
+ * co_returns is sent as the positional result, so a coroutine returning a
+ * tuple replies with the tuple's elements. A coroutine returning
+ * awaitable<void> replies with an empty result, unless it has already replied
+ * through the invocation. An exception escaping the coroutine is replied with
+ * "wamp.error.runtime_error", the same as for a plain procedure.
+ *
+ * Every invocation runs on its own copy of the coroutine, which lives until
+ * the invocation completes. A capturing lambda can therefore rely on its
+ * captures while suspended, even if the procedure is unprovided meanwhile.
+ * Whatever the captures refer to must of course still be alive.
+ *
+ * The session's operations can be awaited from within the coroutine by
+ * passing boost::asio::use_awaitable as their completion token, see
+ * wamp_session::async_call().
+ *
+ * @param executor The executor to run the coroutine on.
+ * @param coroutine The coroutine implementing the procedure.
+ *
+ * @return A procedure that can be passed to wamp_session::provide().
+ */
+template <typename Executor, typename Coroutine>
+wamp_procedure make_coroutine_procedure(const Executor& executor, Coroutine coroutine);
+
+} // namespace autobahn
+
+#include "wamp_coroutine.ipp"
+
+#endif // BOOST_ASIO_HAS_CO_AWAIT
+
+#endif // AUTOBAHN_WAMP_COROUTINE_HPP
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <exception>
+
+namespace autobahn {
+
+namespace detail {
+
+/// Replies to the invocation once the coroutine has completed.
+template <typename Result>
+struct coroutine_reply
+{
+    void operator()(std::exception_ptr exception, Result result) const
+    {
+        if (exception) {
+            reply_with_exception(m_invocation, exception);
+        } else if (m_invocation->sendable()) {
+            m_invocation->result(result);
+        }
+    }
+
+    wamp_invocation m_invocation;
+};
+
+template <>
+struct coroutine_reply<void>
+{
+    void operator()(std::exception_ptr exception) const
+    {
+        if (exception) {
+            reply_with_exception(m_invocation, exception);
+        } else if (m_invocation->sendable()) {
+            m_invocation->empty_result();
+        }
+    }
+
+    wamp_invocation m_invocation;
+};
+
+/// Runs the coroutine from a copy kept in this frame, so that anything it
+/// captured outlives it however long it stays suspended.
+template <typename Result, typename Coroutine>
+inline boost::asio::awaitable<Result> run_coroutine(Coroutine coroutine, wamp_invocation invocation)
+{
+    co_return co_await coroutine(std::move(invocation));
+}
+
+} // namespace detail
+
+template <typename Executor, typename Coroutine>
+inline wamp_procedure make_coroutine_procedure(const Executor& executor, Coroutine coroutine)
+{
+    return [executor, coroutine](wamp_invocation invocation) {
+        using result_type = typename decltype(coroutine(invocation))::value_type;
+
+        boost::asio::co_spawn(executor, detail::run_coroutine<result_type>(coroutine, invocation),
+                detail::coroutine_reply<result_type>{invocation});
+    };
+}
+
+} // namespace autobahn
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_DISPATCH_HPP
+#define AUTOBAHN_WAMP_DISPATCH_HPP
+
+#include "wamp_event.hpp"
+#include "wamp_event_handler.hpp"
+#include "wamp_invocation.hpp"
+#include "wamp_procedure.hpp"
+#include "boost_config.hpp"
+
+#include <boost/asio/strand.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * How the calls of a dispatched handler are ordered relative to each other.
+ */
+enum class wamp_dispatch_order
+{
+    /// Calls may run concurrently and complete in any order.
+    unordered,
+    /// Calls run one at a time, in the order they were received.
+    sequential
+};
+
+/// Ordering key for events, see make_dispatched_event_handler
+typedef std::function<std::size_t(const wamp_event&)> wamp_event_ordering_key;
+
+/// Ordering key for invocations, see make_dispatched_procedure
+typedef std::function<std::size_t(const wamp_invocation&)> wamp_invocation_ordering_key;
+
+/*!
+ * Adapts an event handler so that it runs on the given executor.
+ *
+ * The session calls its event handlers on its own strand, so a slow handler
+ * holds up every other message on the connection. A dispatched handler
+ * instead only posts the event to the executor, which may be a thread pool,
+ * a strand or any other asio executor. The event is shared rather than
+ * copied.
+ *
+ * Exceptions escaping the handler are discarded. The session logs those of
+ * handlers it calls itself when debugging is enabled, but a dispatched
+ * handler runs after the session is done with the event, so a handler that
+ * can fail should catch and report its own exceptions.
+ *
+ * @param executor The executor to run the handler on.
+ * @param handler The event handler.
+ * @param order Whether the events are handled one at a time.
+ *
+ * @return An event handler that can be passed to wamp_session::subscribe().
+ */
+template <typename Executor>
+wamp_event_handler make_dispatched_event_handler(
+        const Executor& executor,
+        const wamp_event_handler& handler,
+        wamp_dispatch_order order = wamp_dispatch_order::sequential);
+
+/*!
+ * Adapts an event handler so that it runs on the given executor, handling
+ * events with the same key one at a time and in order.
+ *
+ * Keys are spread over a fixed number of lanes, so events with different
+ * keys may still wait for each other when their keys share a lane. As with
+ * the other overload, exceptions escaping the handler are discarded.
+ *
+ * @param executor The executor to run the handler on.
+ * @param handler The event handler.
+ * @param key Computes the ordering key of an event.
+ * @param lanes The number of events that may be handled concurrently.
+ *
+ * @return An event handler that can be passed to wamp_session::subscribe().
+ */
+template <typename Executor>
+wamp_event_handler make_dispatched_event_handler(
+        const Executor& executor,
+        const wamp_event_handler& handler,
+        const wamp_event_ordering_key& key,
+        std::size_t lanes = 16);
+
+/*!
+ * Adapts a procedure so that it runs on the given executor.
+ *
+ * This is the counterpart of make_dispatched_event_handler() for procedures,
+ * so that one long running procedure doesn't delay the invocations of every
+ * other procedure on the connection. An exception escaping the procedure is
+ * replied with "wamp.error.runtime_error", the same as for a procedure that
+ * isn't dispatched.
+ *
+ * @param executor The executor to run the procedure on.
+ * @param procedure The procedure.
+ * @param order Whether the invocations are handled one at a time.
+ *
+ * @return A procedure that can be passed to wamp_session::provide().
+ */
+template <typename Executor>
+wamp_procedure make_dispatched_procedure(
+        const Executor& executor,
+        const wamp_procedure& procedure,
+        wamp_dispatch_order order = wamp_dispatch_order::unordered);
+
+/*!
+ * Adapts a procedure so that it runs on the given executor, handling
+ * invocations with the same key one at a time and in order.
+ *
+ * @param executor The executor to run the procedure on.
+ * @param procedure The procedure.
+ * @param key Computes the ordering key of an invocation.
+ * @param lanes The number of invocations that may be handled concurrently.
+ *
+ * @return A procedure that can be passed to wamp_session::provide().
+ */
+template <typename Executor>
+wamp_procedure make_dispatched_procedure(
+        const Executor& executor,
+        const wamp_procedure& procedure,
+        const wamp_invocation_ordering_key& key,
+        std::size_t lanes = 16);
+
+namespace detail {
+
+/*!
+ * Posts work to an executor through a fixed set of strands, so that work
+ * posted with the same key runs in order. Without any strands the work is
+ * posted to the executor directly.
+ */
+template <typename Executor>
+class dispatch_lanes
+{
+public:
+    dispatch_lanes(const Executor& executor, std::size_t lanes);
+
+    template <typename Function>
+    void post(std::size_t key, Function&& function);
+
+private:
+    Executor m_executor;
+    std::vector<boost::asio::strand<Executor>> m_lanes;
+};
+
+} // namespace detail
+
+} // namespace autobahn
+
+#include "wamp_dispatch.ipp"
+
+#endif // AUTOBAHN_WAMP_DISPATCH_HPP
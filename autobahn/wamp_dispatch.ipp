@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_arguments.hpp"
+
+#include <boost/asio/post.hpp>
+#include <exception>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace autobahn {
+
+namespace detail {
+
+inline void reply_with_exception(const wamp_invocation& invocation, std::exception_ptr exception)
+{
+    if (!invocation->sendable()) {
+        return;
+    }
+
+    try {
+        std::rethrow_exception(exception);
+    } catch (const std::exception& e) {
+        std::map<std::string, std::string> error_kw_arguments;
+        error_kw_arguments["what"] = e.what();
+        invocation->error("wamp.error.runtime_error", EMPTY_ARGUMENTS, error_kw_arguments);
+    } catch (...) {
+        invocation->error("wamp.error.runtime_error");
+    }
+}
+
+template <typename Executor>
+inline dispatch_lanes<Executor>::dispatch_lanes(const Executor& executor, std::size_t lanes)
+    : m_executor(executor)
+    , m_lanes()
+{
+    m_lanes.reserve(lanes);
+    for (std::size_t index = 0; index < lanes; ++index) {
+        m_lanes.emplace_back(executor);
+    }
+}
+
+template <typename Executor>
+template <typename Function>
+inline void dispatch_lanes<Executor>::post(std::size_t key, Function&& function)
+{
+    if (m_lanes.empty()) {
+        boost::asio::post(m_executor, std::forward<Function>(function));
+    } else {
+        boost::asio::post(m_lanes[key % m_lanes.size()], std::forward<Function>(function));
+    }
+}
+
+template <typename Executor>
+inline std::shared_ptr<dispatch_lanes<Executor>> make_dispatch_lanes(
+        const Executor& executor, wamp_dispatch_order order)
+{
+    std::size_t lanes = order == wamp_dispatch_order::sequential ? 1 : 0;
+    return std::make_shared<dispatch_lanes<Executor>>(executor, lanes);
+}
+
+template <typename Executor>
+inline std::shared_ptr<dispatch_lanes<Executor>> make_dispatch_lanes(
+        const Executor& executor, std::size_t lanes)
+{
+    if (lanes == 0) {
+        throw std::invalid_argument("an ordering key needs at least one lane");
+    }
+
+    return std::make_shared<dispatch_lanes<Executor>>(executor, lanes);
+}
+
+inline void handle_event(const wamp_event_handler& handler, const wamp_event& event)
+{
+    try {
+        handler(event);
+    } catch (...) {
+        // Nobody is waiting on the event, so there is nowhere to report it,
+        // see make_dispatched_event_handler().
+    }
+}
+
+inline void invoke_procedure(const wamp_procedure& procedure, const wamp_invocation& invocation)
+{
+    try {
+        procedure(invocation);
+    } catch (...) {
+        reply_with_exception(invocation, std::current_exception());
+    }
+}
+
+} // namespace detail
+
+template <typename Executor>
+inline wamp_event_handler make_dispatched_event_handler(
+        const Executor& executor,
+        const wamp_event_handler& handler,
+        wamp_dispatch_order order)
+{
+    auto lanes = detail::make_dispatch_lanes(executor, order);
+    return [lanes, handler](const wamp_event& event) {
+        lanes->post(0, [handler, event]() {
+            detail::handle_event(handler, event);
+        });
+    };
+}
+
+template <typename Executor>
+inline wamp_event_handler make_dispatched_event_handler(
+        const Executor& executor,
+        const wamp_event_handler& handler,
+        const wamp_event_ordering_key& key,
+        std::size_t lanes)
+{
+    auto event_lanes = detail::make_dispatch_lanes(executor, lanes);
+    return [event_lanes, handler, key](const wamp_event& event) {
+        event_lanes->post(key(event), [handler, event]() {
+            detail::handle_event(handler, event);
+        });
+    };
+}
+
+template <typename Executor>
+inline wamp_procedure make_dispatched_procedure(
+        const Executor& executor,
+        const wamp_procedure& procedure,
+        wamp_dispatch_order order)
+{
+    auto lanes = detail::make_dispatch_lanes(executor, order);
+    return [lanes, procedure](wamp_invocation invocation) {
+        lanes->post(0, [procedure, invocation]() {
+            detail::invoke_procedure(procedure, invocation);
+        });
+    };
+}
+
+template <typename Executor>
+inline wamp_procedure make_dispatched_procedure(
+        const Executor& executor,
+        const wamp_procedure& procedure,
+        const wamp_invocation_ordering_key& key,
+        std::size_t lanes)
+{
+    auto invocation_lanes = detail::make_dispatch_lanes(executor, lanes);
+    return [invocation_lanes, procedure, key](wamp_invocation invocation) {
+        invocation_lanes->post(key(invocation), [procedure, invocation]() {
+            detail::invoke_procedure(procedure, invocation);
+        });
+    };
+}
+
+} // namespace autobahn
@@ -36,7 +36,9 @@
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace autobahn {
@@ -47,12 +49,36 @@ public:
     wamp_event_impl(msgpack::zone&& zone);
 
 
-    //add URI and details
     /*!
-    * Event URI.  Used by prefix & wildcard subscriptions
-    */
+     * The topic the event was published to. The router only discloses it
+     * for prefix and wildcard subscriptions, so it is empty for an exact
+     * subscription, where it is the subscribed topic anyway.
+     *
+     * The topic is decoded from the event details the first time it is
+     * asked for, so events whose topic isn't needed don't pay for it.
+     */
     const std::string& uri() const;
 
+    /*!
+     * The id the router assigned to the publication.
+     */
+    uint64_t publication_id() const;
+
+    /*!
+     * The session id of the publisher, or zero if the router didn't
+     * disclose it.
+     */
+    uint64_t publisher() const;
+
+    /*!
+     * The details the router sent along with the event, for entries that
+     * have no accessor of their own.
+     *
+     * Example:
+     * `auto role = value_for_key_or<std::string>(event->details(), "publisher_authrole", std::string());`
+     */
+    const msgpack::object& details() const;
+
     /*!
      * The number of positional arguments published by the event.
      */
@@ -196,12 +222,21 @@ public:
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
     void set_details(const msgpack::object& details);
+    void set_publication_id(uint64_t publication_id);
 
 private:
     msgpack::zone m_zone;
     msgpack::object m_arguments;
     msgpack::object m_kw_arguments;
-    std::string m_uri;
+    msgpack::object m_details;
+    uint64_t m_publication_id;
+
+    /*!
+     * The topic, decoded from the details on first use. Handlers may run
+     * on several threads at once, so the decoding is guarded.
+     */
+    mutable std::string m_uri;
+    mutable std::once_flag m_uri_decoded;
 
 };
 
@@ -29,6 +29,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <boost/lexical_cast.hpp>
+#include <mutex>
 #include <stdexcept>
 #include "wamp_arguments.hpp"
 
@@ -38,14 +39,37 @@ inline wamp_event_impl::wamp_event_impl(msgpack::zone&& zone)
     : m_zone(std::move(zone))
     , m_arguments(EMPTY_ARGUMENTS)
     , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_details(EMPTY_KW_ARGUMENTS)
+    , m_publication_id(0)
+    , m_uri()
+    , m_uri_decoded()
 {
 }
 
 inline const std::string& wamp_event_impl::uri() const
 {
+    std::call_once(m_uri_decoded, [this]() {
+        m_uri = value_for_key_or<std::string>(m_details, "topic", std::string());
+    });
+
     return m_uri;
 }
 
+inline uint64_t wamp_event_impl::publication_id() const
+{
+    return m_publication_id;
+}
+
+inline uint64_t wamp_event_impl::publisher() const
+{
+    return value_for_key_or<uint64_t>(m_details, "publisher", 0);
+}
+
+inline const msgpack::object& wamp_event_impl::details() const
+{
+    return m_details;
+}
+
 inline std::size_t wamp_event_impl::number_of_arguments() const
 {
     return m_arguments.type == msgpack::type::ARRAY ? m_arguments.via.array.size : 0;
@@ -178,7 +202,12 @@ inline void wamp_event_impl::set_kw_arguments(const msgpack::object& kw_argument
 
 inline void wamp_event_impl::set_details(const msgpack::object& details)
 {
-    m_uri = value_for_key_or<std::string>(details, "topic", std::string());
+    m_details = details;
+}
+
+inline void wamp_event_impl::set_publication_id(uint64_t publication_id)
+{
+    m_publication_id = publication_id;
 }
 
 } // namespace autobahn
@@ -32,6 +32,8 @@
 #define AUTOBAHN_WAMP_INVOCATION_HPP
 
 #include "wamp_arguments.hpp"
+#include "wamp_buffer_pool.hpp"
+#include "wamp_cancellation_token.hpp"
 
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
@@ -270,6 +272,15 @@ public:
     */
     bool progressive_results_expected() const;
 
+    /*!
+     * The token that is cancelled when the dealer interrupts the invocation,
+     * for instance because the caller cancelled the call. Long running
+     * procedures should check the token or add a handler to it, stop their
+     * work once it is cancelled and reply with an error such as
+     * "wamp.error.canceled".
+     */
+    const wamp_cancellation_token& cancellation_token() const;
+
     /*!
      * Reply to the invocation with an empty result.
      */
@@ -326,11 +337,13 @@ public:
         intermediary
     } ;
 
-    using send_result_fn = std::function<void(const std::shared_ptr<wamp_message>&)>;
+    using send_result_fn = std::function<void(const std::shared_ptr<wamp_message>&, bool /*final*/)>;
     void set_send_result_fn(send_result_fn&&);
     void set_details(const msgpack::object& details);
+    std::uint64_t request_id() const;
     void set_request_id(std::uint64_t);
     void set_zone(msgpack::zone&&);
+    void set_buffer_pool(const std::shared_ptr<wamp_buffer_pool>& buffer_pool);
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
     bool sendable() const;
@@ -351,9 +364,11 @@ private:
     msgpack::object m_kw_arguments;
     msgpack::object m_details;
     send_result_fn m_send_result_fn;
+    std::shared_ptr<wamp_buffer_pool> m_buffer_pool;
     std::uint64_t m_request_id;
     std::string m_uri;
     bool m_progressive_results_expected;
+    wamp_cancellation_token m_cancellation_token;
 };
 
 using wamp_invocation = std::shared_ptr<wamp_invocation_impl>;
@@ -42,8 +42,10 @@ inline wamp_invocation_impl::wamp_invocation_impl()
     , m_arguments(EMPTY_ARGUMENTS)
     , m_kw_arguments(EMPTY_KW_ARGUMENTS)
     , m_send_result_fn()
+    , m_buffer_pool()
     , m_request_id(0)
     , m_progressive_results_expected(false)
+    , m_cancellation_token()
 {
 }
 
@@ -266,6 +268,11 @@ inline bool wamp_invocation_impl::progressive_results_expected() const
     return m_progressive_results_expected;
 }
 
+inline const wamp_cancellation_token& wamp_invocation_impl::cancellation_token() const
+{
+    return m_cancellation_token;
+}
+
 inline void wamp_invocation_impl::empty_result()
 {
     throw_if_not_sendable();
@@ -276,7 +283,7 @@ inline void wamp_invocation_impl::empty_result()
     message->set_field(1, m_request_id);
     message->set_field(2, std::map<int, int>() /* No details */);
 
-    m_send_result_fn(message);
+    m_send_result_fn(message, true);
     m_send_result_fn = send_result_fn();
 }
 
@@ -290,20 +297,17 @@ inline void wamp_invocation_impl::send_result(const List& arguments, wamp_invoca
         return;
     }
     // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list]
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::YIELD));
-    message->set_field(1, m_request_id);
+    std::map<std::string, bool> options;
     if (resultType == intermediary)
     {
-        message->set_field(2, std::map<std::string, bool>{ {"progress", true} });
+        options["progress"] = true;
     }
-    else
-    {
-        message->set_field(2, std::map<int, int>() /* No details */);
-    }
-    message->set_field(3, arguments);
 
-    m_send_result_fn(message);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::YIELD), m_request_id, options, arguments);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+
+    m_send_result_fn(message, resultType != intermediary);
     if (resultType != intermediary)
     {
         //Final result clears send function
@@ -323,23 +327,17 @@ inline void wamp_invocation_impl::send_result(
     }
 
     // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list, ArgumentsKw|dict]
-    auto message = std::make_shared<wamp_message>(5);
-    message->set_field(0, static_cast<int>(message_type::YIELD));
-    message->set_field(1, m_request_id);
-
+    std::map<std::string, bool> options;
     if (resultType == intermediary)
     {
-        message->set_field(2, std::map<std::string, bool>{ {"progress", true} });
-    }
-    else
-    {
-        message->set_field(2, std::map<int, int>() /* No details */);
+        options["progress"] = true;
     }
 
-    message->set_field(3, arguments);
-    message->set_field(4, kw_arguments);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::YIELD), m_request_id, options, arguments, kw_arguments);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
 
-    m_send_result_fn(message);
+    m_send_result_fn(message, resultType != intermediary);
     if (resultType != intermediary)
     {
         //Final result clears send function
@@ -383,7 +381,7 @@ inline void wamp_invocation_impl::error(const std::string& error_uri)
     message->set_field(3, std::map<int, int>() /* No details */);
     message->set_field(4, error_uri);
 
-    m_send_result_fn(message);
+    m_send_result_fn(message, true);
     m_send_result_fn = send_result_fn();
 }
 
@@ -401,7 +399,7 @@ inline void wamp_invocation_impl::error(const std::string& error_uri, const List
     message->set_field(4, error_uri);
     message->set_field(5, arguments);
 
-    m_send_result_fn(message);
+    m_send_result_fn(message, true);
     m_send_result_fn = send_result_fn();
 }
 
@@ -422,7 +420,7 @@ inline void wamp_invocation_impl::error(
     message->set_field(5, arguments);
     message->set_field(6, kw_arguments);
 
-    m_send_result_fn(message);
+    m_send_result_fn(message, true);
     m_send_result_fn = send_result_fn();
 }
 
@@ -438,6 +436,11 @@ inline void wamp_invocation_impl::set_details(const msgpack::object& details)
     m_details = details;
 }
 
+inline std::uint64_t wamp_invocation_impl::request_id() const
+{
+    return m_request_id;
+}
+
 inline void wamp_invocation_impl::set_request_id(std::uint64_t request_id)
 {
     m_request_id = request_id;
@@ -448,6 +451,11 @@ inline void wamp_invocation_impl::set_zone(msgpack::zone&& zone)
     m_zone = std::move(zone);
 }
 
+inline void wamp_invocation_impl::set_buffer_pool(const std::shared_ptr<wamp_buffer_pool>& buffer_pool)
+{
+    m_buffer_pool = buffer_pool;
+}
+
 inline void wamp_invocation_impl::set_arguments(const msgpack::object& arguments)
 {
     m_arguments = arguments;
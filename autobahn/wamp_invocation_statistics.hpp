@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_INVOCATION_STATISTICS_HPP
+#define AUTOBAHN_WAMP_INVOCATION_STATISTICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace autobahn {
+
+/*!
+ * Counters describing the invocations of a registered procedure that the
+ * session has admitted, queued and rejected.
+ */
+class wamp_invocation_statistics
+{
+public:
+    wamp_invocation_statistics();
+
+    /*!
+     * The number of invocations that are currently running.
+     */
+    std::size_t running() const;
+
+    /*!
+     * The number of invocations that are currently waiting to run.
+     */
+    std::size_t queued() const;
+
+    /*!
+     * The number of invocations that were answered with "wamp.error.busy"
+     * because the queue was full.
+     */
+    uint64_t rejected() const;
+
+    void record_started();
+    void record_finished();
+    void record_queued();
+    void record_dequeued();
+    void record_rejected();
+
+private:
+    std::size_t m_running;
+    std::size_t m_queued;
+    uint64_t m_rejected;
+};
+
+} // namespace autobahn
+
+#include "wamp_invocation_statistics.ipp"
+
+#endif // AUTOBAHN_WAMP_INVOCATION_STATISTICS_HPP
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_invocation_statistics::wamp_invocation_statistics()
+    : m_running(0)
+    , m_queued(0)
+    , m_rejected(0)
+{
+}
+
+inline std::size_t wamp_invocation_statistics::running() const
+{
+    return m_running;
+}
+
+inline std::size_t wamp_invocation_statistics::queued() const
+{
+    return m_queued;
+}
+
+inline uint64_t wamp_invocation_statistics::rejected() const
+{
+    return m_rejected;
+}
+
+inline void wamp_invocation_statistics::record_started()
+{
+    m_running++;
+}
+
+inline void wamp_invocation_statistics::record_finished()
+{
+    m_running--;
+}
+
+inline void wamp_invocation_statistics::record_queued()
+{
+    m_queued++;
+}
+
+inline void wamp_invocation_statistics::record_dequeued()
+{
+    m_queued--;
+}
+
+inline void wamp_invocation_statistics::record_rejected()
+{
+    m_rejected++;
+}
+
+} // namespace autobahn
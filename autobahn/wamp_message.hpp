@@ -31,11 +31,15 @@
 #ifndef AUTOBAHN_WAMP_MESSAGE_HPP
 #define AUTOBAHN_WAMP_MESSAGE_HPP
 
+#include "wamp_buffer_pool.hpp"
+
 #include <msgpack/zone.hpp>
 #include <msgpack/object.hpp>
+#include <msgpack/pack.hpp>
+#include <msgpack/unpack.hpp>
 
 #include <cstddef>
-#include <vector>
+#include <memory>
 
 namespace autobahn {
 
@@ -56,11 +60,11 @@ class wamp_message
 {
 public:
     /*!
-     * A convenience type for representing message fields
+     * Constructs an empty wamp message. Nothing is allocated until
+     * the message is assigned to.
      */
-    using message_fields = std::vector<msgpack::object>;
+    wamp_message();
 
-public:
     /*!
      * Constructs a wamp message with the given number of fields.
      *
@@ -77,12 +81,24 @@ public:
     wamp_message(std::size_t num_fields, msgpack::zone&& zone);
 
     /*!
-     * Constructs a wamp message with the given fields.
+     * Constructs a wamp message that views the elements of an unpacked
+     * array in place. No fields are copied, so the array must have been
+     * allocated from the given zone. Throws a protocol error if the object
+     * is not an array.
      *
-     * @param fields The fields in the message.
-     * @param zone The zone used to allocate fields in the message.
+     * @param fields The array holding the fields in the message.
+     * @param zone The zone that the array was allocated from.
      */
-    wamp_message(message_fields&& fields, msgpack::zone&& zone);
+    wamp_message(const msgpack::object& fields, std::unique_ptr<msgpack::zone>&& zone);
+
+    /*!
+     * Constructs a wamp message that has already been serialized, see
+     * serialize_message(). Transports write the buffer as it is. The
+     * message has no fields of its own that can be accessed.
+     *
+     * @param serialized The buffer holding the serialized message.
+     */
+    explicit wamp_message(wamp_buffer_ptr&& serialized);
 
     wamp_message(const wamp_message& other) = delete;
     wamp_message(wamp_message&& other);
@@ -140,21 +156,36 @@ public:
     std::size_t size() const;
 
     /*!
-     * The message fields.
+     * The message fields as an array object. The array refers to the
+     * fields in place and is only valid for as long as the zone is.
      *
      * @return The message fields.
      */
-    const message_fields& fields() const;
+    msgpack::object fields() const;
 
     /*!
-     * Pilfers the message fields.
+     * Determines whether the message has already been serialized.
+     */
+    bool is_serialized() const;
+
+    /*!
+     * The serialized message, or null if the message is made up of
+     * fields that have yet to be serialized.
      *
-     * @return The message fields.
+     * @return The buffer holding the serialized message.
      */
-    message_fields&& fields();
+    const wamp_buffer_ptr& serialized() const;
 
     /*!
-     * Pilfers the message zone.
+     * Pilfers the serialized message.
+     *
+     * @return The buffer holding the serialized message.
+     */
+    wamp_buffer_ptr&& serialized();
+
+    /*!
+     * Pilfers the message zone. The fields live in the zone, so they
+     * remain usable only for as long as the pilfered zone is kept alive.
      *
      * @return The message zone.
      */
@@ -162,19 +193,37 @@ public:
 
 private:
     /*!
-     * The zone used to allocate message fields. The zone must outlive
-     * the fields. If the fields are pilfered then the zone must also
-     * be pilferred and stored along with the fields.
+     * The zone used to allocate message fields, including the storage
+     * for the field array itself. Serialized and empty messages have
+     * no fields, so their zone is only created if it is asked for.
      */
-    msgpack::zone m_zone;
+    std::unique_ptr<msgpack::zone> m_zone;
 
     /*!
      * The fields comprising of the message. It is up to the user of this
      * class to ensure that a valid wamp message has been constructed.
      */
-    message_fields m_fields;
+    msgpack::object_array m_fields;
+
+    /*!
+     * The serialized message, if it was packed directly from typed
+     * arguments rather than built up from fields.
+     */
+    wamp_buffer_ptr m_serialized;
 };
 
+/*!
+ * Serializes a wamp message straight into the given buffer. Each field is
+ * packed through its msgpack adaptor, so arguments such as containers or
+ * MSGPACK_DEFINE structs are written to the buffer directly, rather than
+ * first being deep copied into msgpack objects.
+ *
+ * @param buffer The buffer to serialize into.
+ * @param fields The fields in the message.
+ */
+template <typename... Fields>
+void serialize_message(msgpack::sbuffer& buffer, const Fields&... fields);
+
 /// Convenience operator for outputting a raw wamp message.
 std::ostream& operator<<(std::ostream& os, const wamp_message& message);
 
@@ -28,34 +28,70 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "exceptions.hpp"
 #include "wamp_message_type.hpp"
 
+#include <new>
 #include <stdexcept>
 
 namespace autobahn {
 
-inline wamp_message::wamp_message(std::size_t num_fields)
+inline wamp_message::wamp_message()
     : m_zone()
-    , m_fields(num_fields)
+    , m_fields()
+{
+    m_fields.size = 0;
+    m_fields.ptr = nullptr;
+}
+
+inline wamp_message::wamp_message(std::size_t num_fields)
+    : wamp_message(num_fields, msgpack::zone())
 {
 }
 
 inline wamp_message::wamp_message(std::size_t num_fields, msgpack::zone&& zone)
-    : m_zone(std::move(zone))
-    , m_fields(num_fields)
+    : m_zone(new msgpack::zone(std::move(zone)))
+    , m_fields()
 {
+    m_fields.size = static_cast<uint32_t>(num_fields);
+    m_fields.ptr = nullptr;
+
+    if (num_fields > 0) {
+        m_fields.ptr = static_cast<msgpack::object*>(
+                m_zone->allocate_align(sizeof(msgpack::object) * num_fields));
+        for (std::size_t index = 0; index < num_fields; ++index) {
+            new (&m_fields.ptr[index]) msgpack::object();
+        }
+    }
 }
 
-inline wamp_message::wamp_message(message_fields&& fields, msgpack::zone&& zone)
+inline wamp_message::wamp_message(const msgpack::object& fields, std::unique_ptr<msgpack::zone>&& zone)
     : m_zone(std::move(zone))
-    , m_fields(std::move(fields))
+    , m_fields()
+{
+    if (fields.type != msgpack::type::ARRAY) {
+        throw protocol_error("invalid message: not an array");
+    }
+
+    m_fields = fields.via.array;
+}
+
+inline wamp_message::wamp_message(wamp_buffer_ptr&& serialized)
+    : m_zone()
+    , m_fields()
+    , m_serialized(std::move(serialized))
 {
+    m_fields.size = 0;
+    m_fields.ptr = nullptr;
 }
 
 inline wamp_message::wamp_message(wamp_message&& other)
+    : m_zone(std::move(other.m_zone))
+    , m_fields(other.m_fields)
+    , m_serialized(std::move(other.m_serialized))
 {
-    m_zone = std::move(other.m_zone);
-    m_fields = std::move(other.m_fields);
+    other.m_fields.size = 0;
+    other.m_fields.ptr = nullptr;
 }
 
 inline wamp_message& wamp_message::operator=(wamp_message&& other)
@@ -65,66 +101,113 @@ inline wamp_message& wamp_message::operator=(wamp_message&& other)
     }
 
     m_zone = std::move(other.m_zone);
-    m_fields = std::move(other.m_fields);
+    m_fields = other.m_fields;
+    m_serialized = std::move(other.m_serialized);
+
+    other.m_fields.size = 0;
+    other.m_fields.ptr = nullptr;
 
     return *this;
 }
 
 inline const msgpack::object& wamp_message::field(std::size_t index) const
 {
-    if (index >= m_fields.size()) {
+    if (index >= m_fields.size) {
         throw std::out_of_range("invalid message field index");
     }
 
-    return m_fields[index];
+    return m_fields.ptr[index];
 }
 
 template <typename Type>
 inline Type wamp_message::field(std::size_t index)
 {
-    if (index >= m_fields.size()) {
+    if (index >= m_fields.size) {
         throw std::out_of_range("invalid message field index");
     }
 
-    return m_fields[index].as<Type>();
+    return m_fields.ptr[index].as<Type>();
 }
 
 template <typename Type>
 inline void wamp_message::set_field(std::size_t index, const Type& type)
 {
-    if (index >= m_fields.size()) {
+    if (index >= m_fields.size) {
         throw std::out_of_range("invalid message field index");
     }
 
-    m_fields[index] = msgpack::object(type, m_zone);
+    m_fields.ptr[index] = msgpack::object(type, *m_zone);
 }
 
 inline bool wamp_message::is_field_type(std::size_t index, msgpack::type::object_type type) const
 {
-    if (index >= m_fields.size()) {
+    if (index >= m_fields.size) {
         throw std::out_of_range("invalid message field index");
     }
 
-    return m_fields[index].type == type;
+    return m_fields.ptr[index].type == type;
 }
 
 inline std::size_t wamp_message::size() const
 {
-    return m_fields.size();
+    return m_fields.size;
 }
 
-inline wamp_message::message_fields&& wamp_message::fields()
+inline msgpack::object wamp_message::fields() const
 {
-    return std::move(m_fields);
+    msgpack::object fields;
+    fields.type = msgpack::type::ARRAY;
+    fields.via.array = m_fields;
+
+    return fields;
+}
+
+inline bool wamp_message::is_serialized() const
+{
+    return m_serialized != nullptr;
+}
+
+inline const wamp_buffer_ptr& wamp_message::serialized() const
+{
+    return m_serialized;
+}
+
+inline wamp_buffer_ptr&& wamp_message::serialized()
+{
+    return std::move(m_serialized);
 }
 
 inline msgpack::zone&& wamp_message::zone()
 {
-    return std::move(m_zone);
+    if (!m_zone) {
+        m_zone.reset(new msgpack::zone());
+    }
+
+    return std::move(*m_zone);
+}
+
+template <typename... Fields>
+inline void serialize_message(msgpack::sbuffer& buffer, const Fields&... fields)
+{
+    msgpack::packer<msgpack::sbuffer> packer(buffer);
+    packer.pack_array(sizeof...(Fields));
+
+    using expand = int[];
+    (void) expand { 0, (packer.pack(fields), 0)... };
 }
 
 inline std::ostream& operator<<(std::ostream& os, const wamp_message& message)
 {
+    if (message.is_serialized()) {
+        const auto& serialized = message.serialized();
+
+        msgpack::unpacked result;
+        msgpack::unpack(result, serialized->data(), serialized->size());
+
+        wamp_message unpacked(result.get(), std::move(result.zone()));
+        return os << unpacked;
+    }
+
     std::size_t num_fields = message.size();
     if (num_fields == 0) {
         os << "unknown []";
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_MPSC_QUEUE_HPP
+#define AUTOBAHN_WAMP_MPSC_QUEUE_HPP
+
+#include <boost/lockfree/queue.hpp>
+#include <boost/lockfree/stack.hpp>
+#include <cstddef>
+
+namespace autobahn {
+
+/*!
+ * A lock free queue that any number of threads may push onto and a single
+ * thread pops from. Values are held in nodes that are recycled through a
+ * lock free free list, so once the queue has warmed up neither pushing nor
+ * popping allocates.
+ *
+ * @tparam T The queued type, which must be default constructible and move
+ *           assignable.
+ */
+template <typename T>
+class wamp_mpsc_queue
+{
+public:
+    /*!
+     * Constructs a queue.
+     *
+     * @param initial_capacity The number of nodes to allocate up front.
+     */
+    explicit wamp_mpsc_queue(std::size_t initial_capacity = 256);
+
+    ~wamp_mpsc_queue();
+
+    wamp_mpsc_queue(const wamp_mpsc_queue& other) = delete;
+    wamp_mpsc_queue& operator=(const wamp_mpsc_queue& other) = delete;
+
+    /*!
+     * Pushes a value onto the queue. Safe to call from any thread.
+     *
+     * @param value The value to push.
+     */
+    void push(T&& value);
+
+    /*!
+     * Pops the value at the front of the queue. Must only be called from
+     * the consuming thread.
+     *
+     * @param value Assigned the popped value.
+     *
+     * @return Whether a value was popped.
+     */
+    bool pop(T& value);
+
+private:
+    struct node
+    {
+        T m_value;
+    };
+
+    node* acquire_node();
+    void release_node(node* free_node);
+
+private:
+    /*!
+     * The queued nodes, in the order they were pushed.
+     */
+    boost::lockfree::queue<node*> m_queue;
+
+    /*!
+     * Nodes that are not currently queued.
+     */
+    boost::lockfree::stack<node*> m_free_nodes;
+};
+
+} // namespace autobahn
+
+#include "wamp_mpsc_queue.ipp"
+
+#endif // AUTOBAHN_WAMP_MPSC_QUEUE_HPP
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include <utility>
+
+namespace autobahn {
+
+template <typename T>
+inline wamp_mpsc_queue<T>::wamp_mpsc_queue(std::size_t initial_capacity)
+    : m_queue(initial_capacity)
+    , m_free_nodes(initial_capacity)
+{
+    for (std::size_t index = 0; index < initial_capacity; ++index) {
+        m_free_nodes.unsynchronized_push(new node());
+    }
+}
+
+template <typename T>
+inline wamp_mpsc_queue<T>::~wamp_mpsc_queue()
+{
+    node* free_node = nullptr;
+    while (m_queue.unsynchronized_pop(free_node)) {
+        delete free_node;
+    }
+    while (m_free_nodes.unsynchronized_pop(free_node)) {
+        delete free_node;
+    }
+}
+
+template <typename T>
+inline void wamp_mpsc_queue<T>::push(T&& value)
+{
+    node* queued_node = acquire_node();
+    queued_node->m_value = std::move(value);
+
+    if (!m_queue.push(queued_node)) {
+        release_node(queued_node);
+        throw std::bad_alloc();
+    }
+}
+
+template <typename T>
+inline bool wamp_mpsc_queue<T>::pop(T& value)
+{
+    node* queued_node = nullptr;
+    if (!m_queue.pop(queued_node)) {
+        return false;
+    }
+
+    value = std::move(queued_node->m_value);
+    release_node(queued_node);
+
+    return true;
+}
+
+template <typename T>
+inline typename wamp_mpsc_queue<T>::node* wamp_mpsc_queue<T>::acquire_node()
+{
+    node* free_node = nullptr;
+    if (m_free_nodes.pop(free_node)) {
+        return free_node;
+    }
+
+    return new node();
+}
+
+template <typename T>
+inline void wamp_mpsc_queue<T>::release_node(node* free_node)
+{
+    // Leave nothing behind in the node that could keep resources alive
+    // while it sits on the free list.
+    free_node->m_value = T();
+
+    if (!m_free_nodes.push(free_node)) {
+        delete free_node;
+    }
+}
+
+} // namespace autobahn
@@ -33,13 +33,15 @@
 
 #include "wamp_arguments.hpp"
 #include "wamp_invocation.hpp"
+#include "wamp_provide_options.hpp"
 
 namespace autobahn {
 
 /// Handler type for use with wamp_session::provide
 using wamp_procedure = std::function<void(wamp_invocation)>;
 
-using provide_options = wamp_kw_arguments;
+/// Options for use with wamp_session::provide
+using provide_options = wamp_provide_options;
 
 } // namespace autobahn
 
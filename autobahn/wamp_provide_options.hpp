@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_PROVIDE_OPTIONS_HPP
+#define AUTOBAHN_WAMP_PROVIDE_OPTIONS_HPP
+
+#include "wamp_arguments.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+
+namespace autobahn {
+
+/*!
+ * Options for registering a procedure. Besides the options passed to the
+ * router in the REGISTER message, they bound how many invocations of the
+ * procedure the session runs at once.
+ */
+class wamp_provide_options
+{
+public:
+    wamp_provide_options();
+
+    /*!
+     * Creates options from the options to pass to the router, so that a
+     * plain map can still be passed wherever options are expected.
+     */
+    wamp_provide_options(const wamp_kw_arguments& options);
+    wamp_provide_options(std::initializer_list<wamp_kw_arguments::value_type> options);
+
+    wamp_provide_options(wamp_provide_options&& other) = delete;
+    wamp_provide_options(const wamp_provide_options& other) = delete;
+    wamp_provide_options& operator=(wamp_provide_options&& other) = delete;
+    wamp_provide_options& operator=(const wamp_provide_options& other) = delete;
+
+    /*!
+     * The options passed to the router in the REGISTER message.
+     */
+    const wamp_kw_arguments& options() const;
+    void set_options(const wamp_kw_arguments& options);
+
+    /*!
+     * The largest number of invocations that run at once, or zero if
+     * there is no limit.
+     */
+    std::size_t max_concurrency() const;
+
+    /*!
+     * Limits how many invocations of the procedure run at once. An
+     * invocation is running from when the procedure is called until it
+     * sends its final result or error. Invocations beyond the limit wait
+     * in the queue, see set_max_queue_depth().
+     */
+    void set_max_concurrency(std::size_t max_concurrency);
+
+    /*!
+     * The largest number of invocations that wait for a running one to
+     * finish.
+     */
+    std::size_t max_queue_depth() const;
+
+    /*!
+     * Sets how many invocations may wait, in the order they arrived, once
+     * max_concurrency() of them are running. Invocations arriving when the
+     * queue is full are answered right away with "wamp.error.busy". The
+     * depth is zero by default, so that invocations beyond the concurrency
+     * limit are all rejected.
+     */
+    void set_max_queue_depth(std::size_t max_queue_depth);
+
+private:
+    wamp_kw_arguments m_options;
+    std::size_t m_max_concurrency;
+    std::size_t m_max_queue_depth;
+};
+
+} // namespace autobahn
+
+#include "wamp_provide_options.ipp"
+
+#endif // AUTOBAHN_WAMP_PROVIDE_OPTIONS_HPP
@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_provide_options::wamp_provide_options()
+    : m_options()
+    , m_max_concurrency(0)
+    , m_max_queue_depth(0)
+{
+}
+
+inline wamp_provide_options::wamp_provide_options(const wamp_kw_arguments& options)
+    : m_options(options)
+    , m_max_concurrency(0)
+    , m_max_queue_depth(0)
+{
+}
+
+inline wamp_provide_options::wamp_provide_options(
+        std::initializer_list<wamp_kw_arguments::value_type> options)
+    : m_options(options)
+    , m_max_concurrency(0)
+    , m_max_queue_depth(0)
+{
+}
+
+inline const wamp_kw_arguments& wamp_provide_options::options() const
+{
+    return m_options;
+}
+
+inline void wamp_provide_options::set_options(const wamp_kw_arguments& options)
+{
+    m_options = options;
+}
+
+inline std::size_t wamp_provide_options::max_concurrency() const
+{
+    return m_max_concurrency;
+}
+
+inline void wamp_provide_options::set_max_concurrency(std::size_t max_concurrency)
+{
+    m_max_concurrency = max_concurrency;
+}
+
+inline std::size_t wamp_provide_options::max_queue_depth() const
+{
+    return m_max_queue_depth;
+}
+
+inline void wamp_provide_options::set_max_queue_depth(std::size_t max_queue_depth)
+{
+    m_max_queue_depth = max_queue_depth;
+}
+
+} // namespace autobahn
@@ -35,7 +35,7 @@
 
 namespace autobahn {
 
-/// Represents a topic subscription.
+/// Represents a publication to a topic.
 class wamp_publication
 {
 public:
@@ -54,8 +54,23 @@ public:
 
     void set_exclude_me(const bool& exclude_me);
 
+    /*!
+     * Whether or not the router is asked to acknowledge the publication.
+     */
+    const bool& acknowledge() const;
+
+    /*!
+     * Asks the router to acknowledge the publication. The future returned
+     * by publish() then resolves with the publication id once the router
+     * has accepted the event, or fails with the error the router replied
+     * with. Without acknowledgement, the future resolves as soon as the
+     * event has been handed to the transport.
+     */
+    void set_acknowledge(const bool& acknowledge);
+
 private:
     bool m_exclude_me;
+    bool m_acknowledge;
 };
 
 } // namespace autobahn
@@ -36,6 +36,7 @@ namespace autobahn {
 
 inline wamp_publish_options::wamp_publish_options()
     : m_exclude_me(true) //default
+    , m_acknowledge(false)
 {
 }
 
@@ -49,6 +50,16 @@ inline void wamp_publish_options::set_exclude_me(const bool& exclude_me)
     m_exclude_me = exclude_me;
 }
 
+inline const bool& wamp_publish_options::acknowledge() const
+{
+    return m_acknowledge;
+}
+
+inline void wamp_publish_options::set_acknowledge(const bool& acknowledge)
+{
+    m_acknowledge = acknowledge;
+}
+
 } // namespace autobahn
 
 namespace msgpack {
@@ -70,6 +81,11 @@ struct convert<autobahn::wamp_publish_options>
             options.set_exclude_me( options_map_itr->second.as<bool>());
         }
 
+        const auto acknowledge_itr = options_map.find("acknowledge");
+        if (acknowledge_itr != options_map.end()) {
+            options.set_acknowledge(acknowledge_itr->second.as<bool>());
+        }
+
         return object;
     }
 };
@@ -82,13 +98,21 @@ struct pack<autobahn::wamp_publish_options>
             msgpack::packer<Stream>& packer,
             autobahn::wamp_publish_options const& options) const
     {
-        std::unordered_map<std::string, unsigned> options_map;
         const auto& exclude_me = options.exclude_me();
-        if (exclude_me != true) { //true is default, only false msut be transfered
-            options_map["exclude_me"] = exclude_me;
+        const auto& acknowledge = options.acknowledge();
+
+        //true is default for exclude_me and false for acknowledge, only the others must be transfered
+        packer.pack_map((exclude_me ? 0 : 1) + (acknowledge ? 1 : 0));
+        if (!exclude_me) {
+            packer.pack_str(10);
+            packer.pack_str_body("exclude_me", 10);
+            packer.pack_false();
+        }
+        if (acknowledge) {
+            packer.pack_str(11);
+            packer.pack_str_body("acknowledge", 11);
+            packer.pack_true();
         }
-
-        packer.pack(options_map);
 
         return packer;
     }
@@ -108,6 +132,10 @@ struct object_with_zone<autobahn::wamp_publish_options>
             options_map["exclude_me"] = msgpack::object(exclude_me);
         }
 
+        if (options.acknowledge()) {
+            options_map["acknowledge"] = msgpack::object(true);
+        }
+
         object << options_map;
     }
 };
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_RAWSOCKET_OPTIONS_HPP
+#define AUTOBAHN_WAMP_RAWSOCKET_OPTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * Options for a rawsocket transport. These must be set before the
+ * transport is connected.
+ */
+class wamp_rawsocket_options
+{
+public:
+    /*!
+     * How the receive buffer grows when a frame does not fit.
+     */
+    enum class buffer_growth
+    {
+        /*! Grow to exactly the size of the frame. */
+        exact,
+        /*! Keep doubling the buffer until the frame fits. */
+        doubling
+    };
+
+    /*!
+     * Serialization formats that can be proposed during the handshake. The
+     * values are those used on the wire.
+     */
+    enum class serializer : uint8_t
+    {
+        json = 0x01,
+        msgpack = 0x02
+    };
+
+public:
+    wamp_rawsocket_options();
+
+    /*!
+     * The largest message the transport is prepared to receive. This is
+     * advertised to the router during the handshake, and frames exceeding
+     * it are rejected before any memory is allocated for them.
+     */
+    const uint32_t& max_message_length() const;
+
+    /*!
+     * Sets the largest message the transport is prepared to receive. The
+     * rawsocket handshake can only express powers of two between 2^9 and
+     * 2^24 octets, so anything else throws std::invalid_argument.
+     */
+    void set_max_message_length(const uint32_t& max_message_length);
+
+    /*!
+     * The serializers the transport may use, in order of preference. The
+     * most preferred one is proposed during the handshake.
+     */
+    const std::vector<serializer>& serializers() const;
+
+    /*!
+     * Sets the serializers the transport may use, in order of preference.
+     * Throws std::invalid_argument if the list is empty or names a
+     * serializer that is not supported.
+     */
+    void set_serializers(const std::vector<serializer>& serializers);
+
+    const std::size_t& initial_receive_buffer_size() const;
+    void set_initial_receive_buffer_size(const std::size_t& size);
+
+    const buffer_growth& receive_buffer_growth() const;
+    void set_receive_buffer_growth(const buffer_growth& growth);
+
+    /*!
+     * The receive buffer size above which the buffer is released after the
+     * frame it was grown for has been processed, so that an occasional large
+     * message does not pin memory for the rest of the connection.
+     */
+    const std::size_t& receive_buffer_shrink_threshold() const;
+    void set_receive_buffer_shrink_threshold(const std::size_t& threshold);
+
+private:
+    uint32_t m_max_message_length;
+    std::vector<serializer> m_serializers;
+    std::size_t m_initial_receive_buffer_size;
+    buffer_growth m_receive_buffer_growth;
+    std::size_t m_receive_buffer_shrink_threshold;
+};
+
+} // namespace autobahn
+
+#include "wamp_rawsocket_options.ipp"
+
+#endif // AUTOBAHN_WAMP_RAWSOCKET_OPTIONS_HPP
@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+namespace autobahn {
+
+inline wamp_rawsocket_options::wamp_rawsocket_options()
+    : m_max_message_length(1u << 24)
+    , m_serializers({ serializer::msgpack })
+    , m_initial_receive_buffer_size(64 * 1024)
+    , m_receive_buffer_growth(buffer_growth::doubling)
+    , m_receive_buffer_shrink_threshold(1024 * 1024)
+{
+}
+
+inline const uint32_t& wamp_rawsocket_options::max_message_length() const
+{
+    return m_max_message_length;
+}
+
+inline void wamp_rawsocket_options::set_max_message_length(const uint32_t& max_message_length)
+{
+    bool power_of_two = (max_message_length & (max_message_length - 1)) == 0;
+    if (!power_of_two || max_message_length < (1u << 9) || max_message_length > (1u << 24)) {
+        throw std::invalid_argument("rawsocket max message length must be a power of two between 2^9 and 2^24");
+    }
+
+    m_max_message_length = max_message_length;
+}
+
+inline const std::vector<wamp_rawsocket_options::serializer>& wamp_rawsocket_options::serializers() const
+{
+    return m_serializers;
+}
+
+inline void wamp_rawsocket_options::set_serializers(const std::vector<serializer>& serializers)
+{
+    if (serializers.empty()) {
+        throw std::invalid_argument("at least one rawsocket serializer is required");
+    }
+
+    for (const auto& s : serializers) {
+        if (s != serializer::msgpack) {
+            throw std::invalid_argument("only the msgpack rawsocket serializer is currently supported");
+        }
+    }
+
+    m_serializers = serializers;
+}
+
+inline const std::size_t& wamp_rawsocket_options::initial_receive_buffer_size() const
+{
+    return m_initial_receive_buffer_size;
+}
+
+inline void wamp_rawsocket_options::set_initial_receive_buffer_size(const std::size_t& size)
+{
+    m_initial_receive_buffer_size = size;
+}
+
+inline const wamp_rawsocket_options::buffer_growth& wamp_rawsocket_options::receive_buffer_growth() const
+{
+    return m_receive_buffer_growth;
+}
+
+inline void wamp_rawsocket_options::set_receive_buffer_growth(const buffer_growth& growth)
+{
+    m_receive_buffer_growth = growth;
+}
+
+inline const std::size_t& wamp_rawsocket_options::receive_buffer_shrink_threshold() const
+{
+    return m_receive_buffer_shrink_threshold;
+}
+
+inline void wamp_rawsocket_options::set_receive_buffer_shrink_threshold(const std::size_t& threshold)
+{
+    m_receive_buffer_shrink_threshold = threshold;
+}
+
+} // namespace autobahn
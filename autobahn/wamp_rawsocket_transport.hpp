@@ -32,12 +32,18 @@
 #define AUTOBAHN_WAMP_NETWORK_TRANSPORT_HPP
 
 #include "boost_config.hpp"
+#include "wamp_batch_options.hpp"
+#include "wamp_batch_statistics.hpp"
+#include "wamp_buffer_pool.hpp"
+#include "wamp_rawsocket_options.hpp"
 #include "wamp_transport.hpp"
 
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <cstddef>
 #include <memory>
 #include <msgpack/unpack.hpp>
+#include <vector>
 
 namespace autobahn {
 
@@ -99,14 +105,65 @@ public:
      */
     virtual bool is_connected() const override;
 
+    /*!
+     * @copydoc wamp_transport::strand()
+     */
+    virtual wamp_strand strand() const override;
+
     /*
      * SENDER INTERFACE
      */
     /*!
-     * @copydoc wamp_transport::send_message()
+     * Queues the message for sending over the transport. The message is
+     * serialized immediately and written asynchronously, so this never
+     * blocks on the socket. With batching enabled the write is deferred
+     * so that it can be coalesced with other messages.
+     *
+     * @param message The message to be sent.
      */
     virtual void send_message(wamp_message&& message) override;
 
+    /*!
+     * Queues the messages for sending over the transport and writes them
+     * out together in a single gathered write, without waiting for the
+     * batching delay. Nothing is queued if any of the messages is larger
+     * than the router accepts.
+     *
+     * @param messages The messages to be sent.
+     */
+    virtual void send_messages(std::vector<wamp_message>&& messages) override;
+
+    /*!
+     * Sets the options for the transport. These must be set before the
+     * transport is connected.
+     *
+     * @param options The rawsocket options.
+     */
+    void set_options(const wamp_rawsocket_options& options);
+
+    /*!
+     * @return The options for the transport.
+     */
+    const wamp_rawsocket_options& options() const;
+
+    /*!
+     * Sets the options used to coalesce outbound messages. Changes apply
+     * to messages sent after the call.
+     *
+     * @param options The batching options.
+     */
+    void set_batch_options(const wamp_batch_options& options);
+
+    /*!
+     * @return The options used to coalesce outbound messages.
+     */
+    const wamp_batch_options& batch_options() const;
+
+    /*!
+     * @return Counters for the writes issued by this transport.
+     */
+    const wamp_batch_statistics& batch_statistics() const;
+
     /*!
      * @copydoc wamp_transport::set_pause_handler()
      */
@@ -117,13 +174,29 @@ public:
      */
     virtual void set_resume_handler(resume_handler&& handler) override;
 
+    /*!
+     * @copydoc wamp_transport::get_pause_handler()
+     */
+    virtual pause_handler get_pause_handler() const override;
+
+    /*!
+     * @copydoc wamp_transport::get_resume_handler()
+     */
+    virtual resume_handler get_resume_handler() const override;
+
+    /*!
+     * @copydoc wamp_transport::buffer_pool()
+     */
+    virtual std::shared_ptr<wamp_buffer_pool> buffer_pool() const override;
+
     /*
      * RECEIVER INTERFACE
      */
     /*!
      * Pause receiving of messages. This will prevent the transport from receiving
      * any more messages until it has been resumed. This is used to excert
-     * backpressure on the sending peer.
+     * backpressure on the sending peer. No further reads are issued on the
+     * socket, so the peer is eventually held back by TCP flow control.
      */
     virtual void pause() override;
 
@@ -133,6 +206,23 @@ public:
      */
     virtual void resume() override;
 
+    /*!
+     * Sets the outbound watermarks. Once the number of octets queued for
+     * sending reaches the high watermark the pause handler is invoked. The
+     * resume handler is invoked once the queue has drained down to the low
+     * watermark.
+     *
+     * @param low_watermark The queue size at which sending may resume.
+     * @param high_watermark The queue size at which sending should pause.
+     */
+    void set_send_watermarks(std::size_t low_watermark, std::size_t high_watermark);
+
+    /*!
+     * @return The number of octets queued for sending, including those
+     *         currently being written.
+     */
+    std::size_t queued_bytes() const;
+
     /*!
      * @copydoc wamp_transport::attach()
      */
@@ -154,6 +244,10 @@ protected:
 
 private:
 
+    void handshake_request_handler(
+            const boost::system::error_code& error_code,
+            std::size_t /* bytes_transferred */);
+
     void handshake_reply_handler(
             const boost::system::error_code& error_code,
             std::size_t /* bytes_transferred */);
@@ -168,7 +262,50 @@ private:
             const boost::system::error_code& error,
             std::size_t /* bytes transferred */);
 
+    void receive_error(const boost::system::error_code& error);
+
+    void reserve_receive_buffer(std::size_t length);
+
+    void update_send_backpressure();
+
+    wamp_buffer_ptr serialize(wamp_message&& message);
+
+    void queue_buffer(wamp_buffer_ptr&& buffer);
+
+    void schedule_flush();
+
+    void flush_queued_messages();
+
+    void flush_timer_handler(const boost::system::error_code& error);
+
+    void write_queued_messages();
+
+    void write_message_handler(
+            const boost::system::error_code& error,
+            std::size_t /* bytes transferred */);
+
+    /*!
+     * Closes a connection that can no longer be used and detaches the
+     * handler, so that it stops waiting on anything sent or received.
+     */
+    void fail_connection(const std::string& reason);
+
 private:
+    /*!
+     * A serialized message waiting to be written along with its
+     * length prefix.
+     */
+    struct outgoing_message
+    {
+        uint32_t m_length;
+        wamp_buffer_ptr m_buffer;
+    };
+
+    /*!
+     * The strand all completion handlers and deferred writes run on.
+     */
+    wamp_strand m_strand;
+
     /*!
      * The underlying socket for the transport.
      */
@@ -204,20 +341,123 @@ private:
      */
     std::shared_ptr<wamp_transport_handler> m_handler;
 
+    /*!
+     * Whether or not the handler has already been detached because the
+     * connection failed, in which case detach() only forgets it.
+     */
+    bool m_handler_detached;
+
     /*!
      * Buffer used for sending and receiving the handshake.
      */
     uint8_t m_handshake_buffer[4];
 
+    /*!
+     * The largest message the router is prepared to receive, as advertised
+     * in its handshake reply.
+     */
+    uint32_t m_remote_max_message_length;
+
     /*!
      * Stores the length of the next serialized message to receive.
      */
     uint32_t m_message_length;
 
     /*!
-     * Used for unpacking serialized messages.
+     * Buffer that the body of each incoming frame is read into.
+     */
+    std::unique_ptr<char[]> m_receive_buffer;
+
+    /*!
+     * The size of the receive buffer.
+     */
+    std::size_t m_receive_buffer_size;
+
+    /*!
+     * The options for the transport.
+     */
+    wamp_rawsocket_options m_options;
+
+    /*!
+     * Pool of buffers for outbound messages. Buffers are returned to it
+     * once they have been written.
+     */
+    std::shared_ptr<wamp_buffer_pool> m_buffer_pool;
+
+    /*!
+     * Messages waiting to be written once the current write completes.
+     */
+    std::vector<outgoing_message> m_send_queue;
+
+    /*!
+     * Messages currently being written. All of them go out in a single
+     * gathered write, so there is never more than one write outstanding
+     * on the socket.
+     */
+    std::vector<outgoing_message> m_write_queue;
+
+    /*!
+     * The buffer sequence for the current write. Kept as a member so that
+     * its storage is reused from one write to the next.
+     */
+    std::vector<boost::asio::const_buffer> m_write_buffers;
+
+    /*!
+     * The number of octets, including length prefixes, in the send queue.
+     */
+    std::size_t m_send_queue_bytes;
+
+    /*!
+     * The number of octets, including length prefixes, in the write queue.
+     */
+    std::size_t m_write_queue_bytes;
+
+    /*!
+     * The queue size at which the resume handler is invoked.
+     */
+    std::size_t m_low_watermark;
+
+    /*!
+     * The queue size at which the pause handler is invoked.
+     */
+    std::size_t m_high_watermark;
+
+    /*!
+     * Whether or not the pause handler has been invoked without a matching
+     * call to the resume handler.
+     */
+    bool m_send_paused;
+
+    /*!
+     * Whether or not receiving has been paused.
+     */
+    bool m_receive_paused;
+
+    /*!
+     * Whether or not the receive loop is waiting for receiving to be resumed
+     * before it reads the next message.
+     */
+    bool m_receive_deferred;
+
+    /*!
+     * Whether or not a deferred flush of the send queue is outstanding.
+     */
+    bool m_flush_pending;
+
+    /*!
+     * Timer used to flush a batch once its delay budget is used up.
+     */
+    boost::asio::steady_timer m_flush_timer;
+
+    /*!
+     * The options used to coalesce outbound messages.
+     */
+    wamp_batch_options m_batch_options;
+
+    /*!
+     * Counters for the writes issued by this transport.
      */
-    msgpack::unpacker m_message_unpacker;
+    wamp_batch_statistics m_batch_statistics;
 
     /*!
      * Whether or not debugging is enabled.
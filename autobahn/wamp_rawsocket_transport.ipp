@@ -32,10 +32,14 @@
 #include "wamp_message.hpp"
 #include "wamp_transport_handler.hpp"
 
+#include <boost/asio/bind_executor.hpp>
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
 #include <boost/asio/placeholders.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
+#include <algorithm>
 #include <system_error>
 
 namespace autobahn {
@@ -46,13 +50,34 @@ wamp_rawsocket_transport<Socket>::wamp_rawsocket_transport(
             const endpoint_type& remote_endpoint,
             bool debug_enabled)
     : wamp_transport()
+    , m_strand(io_service.get_executor())
     , m_socket(io_service)
     , m_remote_endpoint(remote_endpoint)
     , m_connect()
     , m_disconnect()
+    , m_handler()
+    , m_handler_detached(false)
     , m_handshake_buffer()
+    , m_remote_max_message_length(1u << 24)
     , m_message_length(0)
-    , m_message_unpacker()
+    , m_receive_buffer()
+    , m_receive_buffer_size(0)
+    , m_options()
+    , m_buffer_pool(std::make_shared<wamp_buffer_pool>())
+    , m_send_queue()
+    , m_write_queue()
+    , m_write_buffers()
+    , m_send_queue_bytes(0)
+    , m_write_queue_bytes(0)
+    , m_low_watermark(1024 * 1024)
+    , m_high_watermark(4 * 1024 * 1024)
+    , m_send_paused(false)
+    , m_receive_paused(false)
+    , m_receive_deferred(false)
+    , m_flush_pending(false)
+    , m_flush_timer(io_service)
+    , m_batch_options()
+    , m_batch_statistics()
     , m_debug_enabled(debug_enabled)
 {
     memset(m_handshake_buffer, 0, sizeof(m_handshake_buffer));
@@ -82,42 +107,38 @@ boost::future<void> wamp_rawsocket_transport<Socket>::connect()
             return;
         }
 
-        // FIXME: There should be a wamp_rawsocket_properties object or something
-        //        similar that can be passed in to help deal with overiding these
-        //        handshake parameters.
-        //
+        // The maximum message length is advertised as 2**(9 + n) octets,
+        // with n stored in the upper nibble.
+        uint8_t length_exponent = 0;
+        while ((512u << length_exponent) < m_options.max_message_length()) {
+            ++length_exponent;
+        }
+
         // Send the initial handshake packet informing the server which
         // serialization format we wish to use, and our maximum message size.
         m_handshake_buffer[0] = 0x7F; // magic byte
-        m_handshake_buffer[1] = 0xF2; // we are ready to receive messages up to 2**24 octets and encoded using MsgPack
+        m_handshake_buffer[1] = (length_exponent << 4)
+                | static_cast<uint8_t>(m_options.serializers().front());
         m_handshake_buffer[2] = 0x00; // reserved
         m_handshake_buffer[3] = 0x00; // reserved
 
-        boost::asio::write(
-                m_socket,
-                boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)));
-
-        auto handshake_reply = [=](
+        auto handshake_request = [=](
                 const boost::system::error_code& error,
                 std::size_t bytes_transferred) {
             auto shared_self = weak_self.lock();
             if (shared_self) {
-                handshake_reply_handler(error, bytes_transferred);
+                handshake_request_handler(error, bytes_transferred);
             }
         };
 
-        try {
-            // Read the 4-byte handshake reply from the server
-            boost::asio::async_read(
-                    m_socket,
-                    boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)),
-                    handshake_reply);
-        } catch (const std::exception& e) {
-            m_connect.set_exception(boost::copy_exception(e));
-        }
+        boost::asio::async_write(
+                m_socket,
+                boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)),
+                boost::asio::bind_executor(m_strand, handshake_request));
     };
 
-    m_socket.async_connect(m_remote_endpoint, connect_handler);
+    m_socket.async_connect(m_remote_endpoint,
+            boost::asio::bind_executor(m_strand, connect_handler));
 
     return m_connect.get_future();
 }
@@ -129,9 +150,15 @@ boost::future<void> wamp_rawsocket_transport<Socket>::disconnect()
         throw network_error("network transport already disconnected");
     }
 
-    m_socket.close();
+    // The socket is closed from the strand so that it never races with a
+    // handler that is still using it.
+    auto shared_self = this->shared_from_this();
+    boost::asio::dispatch(m_strand, [shared_self]() {
+        shared_self->m_socket.close();
+        shared_self->m_flush_timer.cancel();
+        shared_self->m_disconnect.set_value();
+    });
 
-    m_disconnect.set_value();
     return m_disconnect.get_future();
 }
 
@@ -141,24 +168,133 @@ bool wamp_rawsocket_transport<Socket>::is_connected() const
     return m_socket.is_open();
 }
 
+template <class Socket>
+wamp_strand wamp_rawsocket_transport<Socket>::strand() const
+{
+    return m_strand;
+}
+
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::send_message(wamp_message&& message)
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    packer.pack(message.fields());
+    queue_buffer(serialize(std::move(message)));
 
-    // Write the length prefix as the message header.
-    uint32_t length = htonl(buffer->size());
-    boost::asio::write(m_socket, boost::asio::buffer(&length, sizeof(length)));
+    // Anything queued while a write is in progress is picked up by the
+    // next gathered write once the current one completes.
+    if (m_write_queue.empty()) {
+        if (!m_batch_options.enabled() || m_send_queue_bytes >= m_batch_options.max_bytes()) {
+            write_queued_messages();
+        } else {
+            schedule_flush();
+        }
+    }
 
-    // Write actual serialized message.
-    boost::asio::write(m_socket, boost::asio::buffer(buffer->data(), buffer->size()));
+    update_send_backpressure();
+}
 
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::send_messages(std::vector<wamp_message>&& messages)
+{
+    // Every message is checked before any is queued so that a message the
+    // router won't accept doesn't leave part of the batch behind.
+    std::vector<wamp_buffer_ptr> buffers;
+    buffers.reserve(messages.size());
+    for (auto& message : messages) {
+        buffers.push_back(serialize(std::move(message)));
+    }
+
+    for (auto& buffer : buffers) {
+        queue_buffer(std::move(buffer));
+    }
+
+    // The batch is already as large as the caller wanted it to be, so it
+    // isn't held back for the batching delay.
+    if (m_write_queue.empty()) {
+        write_queued_messages();
+    }
+
+    update_send_backpressure();
+}
+
+template <class Socket>
+wamp_buffer_ptr wamp_rawsocket_transport<Socket>::serialize(wamp_message&& message)
+{
     if (m_debug_enabled) {
-        std::cerr << "TX message (" << buffer->size() << " octets) ..." << std::endl;
         std::cerr << "TX message: " << message << std::endl;
     }
+
+    wamp_buffer_ptr buffer;
+    if (message.is_serialized()) {
+        buffer = std::move(message.serialized());
+    } else {
+        buffer = m_buffer_pool->acquire();
+        msgpack::packer<msgpack::sbuffer> packer(*buffer);
+        packer.pack(message.fields());
+    }
+
+    if (m_debug_enabled) {
+        std::cerr << "TX message (" << buffer->size() << " octets) ..." << std::endl;
+    }
+
+    // Rawsocket has no way of fragmenting a message, so anything the router
+    // has said it won't accept is rejected here rather than costing us the
+    // connection.
+    if (buffer->size() > m_remote_max_message_length) {
+        std::stringstream error_string;
+        error_string << "message of " << buffer->size() << " octets exceeds the router's maximum of "
+                << m_remote_max_message_length << " octets";
+        throw protocol_error(error_string.str());
+    }
+
+    return buffer;
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::queue_buffer(wamp_buffer_ptr&& buffer)
+{
+    // The length prefix is kept alongside the message so that it remains
+    // valid for the duration of the asynchronous write.
+    outgoing_message outgoing;
+    outgoing.m_length = htonl(buffer->size());
+    outgoing.m_buffer = std::move(buffer);
+    m_send_queue_bytes += sizeof(outgoing.m_length) + outgoing.m_buffer->size();
+    m_send_queue.push_back(std::move(outgoing));
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::set_options(const wamp_rawsocket_options& options)
+{
+    m_options = options;
+}
+
+template <class Socket>
+const wamp_rawsocket_options& wamp_rawsocket_transport<Socket>::options() const
+{
+    return m_options;
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::set_batch_options(const wamp_batch_options& options)
+{
+    m_batch_options = options;
+}
+
+template <class Socket>
+const wamp_batch_options& wamp_rawsocket_transport<Socket>::batch_options() const
+{
+    return m_batch_options;
+}
+
+template <class Socket>
+const wamp_batch_statistics& wamp_rawsocket_transport<Socket>::batch_statistics() const
+{
+    return m_batch_statistics;
+}
+
+template <class Socket>
+std::shared_ptr<wamp_buffer_pool> wamp_rawsocket_transport<Socket>::buffer_pool() const
+{
+    return m_buffer_pool;
 }
 
 template <class Socket>
@@ -173,20 +309,66 @@ void wamp_rawsocket_transport<Socket>::set_resume_handler(resume_handler&& handl
     m_resume_handler = std::move(handler);
 }
 
+template <class Socket>
+typename wamp_rawsocket_transport<Socket>::pause_handler
+wamp_rawsocket_transport<Socket>::get_pause_handler() const
+{
+    return m_pause_handler;
+}
+
+template <class Socket>
+typename wamp_rawsocket_transport<Socket>::resume_handler
+wamp_rawsocket_transport<Socket>::get_resume_handler() const
+{
+    return m_resume_handler;
+}
+
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::pause()
 {
-    if (m_pause_handler) {
-        m_pause_handler();
-    }
+    std::weak_ptr<wamp_rawsocket_transport<Socket>> weak_self = this->shared_from_this();
+    boost::asio::dispatch(m_strand, [=]() {
+        auto shared_self = weak_self.lock();
+        if (shared_self) {
+            m_receive_paused = true;
+        }
+    });
 }
 
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::resume()
 {
-    if (m_resume_handler) {
-        m_resume_handler();
+    std::weak_ptr<wamp_rawsocket_transport<Socket>> weak_self = this->shared_from_this();
+    boost::asio::dispatch(m_strand, [=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        m_receive_paused = false;
+        if (m_receive_deferred) {
+            m_receive_deferred = false;
+            receive_message();
+        }
+    });
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::set_send_watermarks(
+        std::size_t low_watermark, std::size_t high_watermark)
+{
+    if (low_watermark > high_watermark) {
+        throw std::invalid_argument("low watermark must not exceed the high watermark");
     }
+
+    m_low_watermark = low_watermark;
+    m_high_watermark = high_watermark;
+}
+
+template <class Socket>
+std::size_t wamp_rawsocket_transport<Socket>::queued_bytes() const
+{
+    return m_send_queue_bytes + m_write_queue_bytes;
 }
 
 template <class Socket>
@@ -198,6 +380,7 @@ void wamp_rawsocket_transport<Socket>::attach(
     }
 
     m_handler = handler;
+    m_handler_detached = false;
 
     m_handler->on_attach(this->shared_from_this());
 }
@@ -209,8 +392,17 @@ void wamp_rawsocket_transport<Socket>::detach()
         throw std::logic_error("no handler attached");
     }
 
-    m_handler->on_detach(true, "wamp.error.goodbye");
-    m_handler.reset();
+    // Handlers are only ever invoked on the strand, so the handler is
+    // detached there too rather than from under a message being delivered.
+    auto shared_self = this->shared_from_this();
+    boost::asio::dispatch(m_strand, [shared_self]() {
+        if (shared_self->m_handler) {
+            if (!shared_self->m_handler_detached) {
+                shared_self->m_handler->on_detach(true, "wamp.error.goodbye");
+            }
+            shared_self->m_handler.reset();
+        }
+    });
 }
 
 template <class Socket>
@@ -225,6 +417,38 @@ Socket& wamp_rawsocket_transport<Socket>::socket()
     return m_socket;
 }
 
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::handshake_request_handler(
+        const boost::system::error_code& error_code,
+        std::size_t /* bytes_transferred */)
+{
+    if (error_code) {
+        if (m_debug_enabled) {
+            std::cerr << "rawsocket handshake error: " << error_code << std::endl;
+        }
+
+        m_connect.set_exception(boost::copy_exception(
+                std::system_error(error_code.value(), std::system_category(), "async_write")));
+        return;
+    }
+
+    std::weak_ptr<wamp_rawsocket_transport<Socket>> weak_self = this->shared_from_this();
+    auto handshake_reply = [=](
+            const boost::system::error_code& error,
+            std::size_t bytes_transferred) {
+        auto shared_self = weak_self.lock();
+        if (shared_self) {
+            handshake_reply_handler(error, bytes_transferred);
+        }
+    };
+
+    // Read the 4-byte handshake reply from the server
+    boost::asio::async_read(
+            m_socket,
+            boost::asio::buffer(m_handshake_buffer, sizeof(m_handshake_buffer)),
+            boost::asio::bind_executor(m_strand, handshake_reply));
+}
+
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::handshake_reply_handler(
         const boost::system::error_code& error_code,
@@ -275,25 +499,34 @@ void wamp_rawsocket_transport<Socket>::handshake_reply_handler(
         return;
     }
 
+    // The router must accept the serializer we proposed, it cannot pick
+    // another one.
     uint32_t serializer_type = (m_handshake_buffer[1] & 0x0F);
-    if (serializer_type == 0x01) {
-        m_connect.set_exception(boost::copy_exception(protocol_error("json currently not supported")));
-    } else if (serializer_type == 0x02) {
-        if (m_debug_enabled) {
-            std::cerr << "connect successful: valid handshake" << std::endl;
-        }
-        m_connect.set_value();
-        receive_message();
-    } else {
+    if (serializer_type != static_cast<uint32_t>(m_options.serializers().front())) {
         std::stringstream error_string;
         error_string << "rawsocket handshake error: invalid serializer type (" << serializer_type << ")";
         m_connect.set_exception(boost::copy_exception(protocol_error(error_string.str())));
+        return;
     }
+
+    m_remote_max_message_length = 512u << (m_handshake_buffer[1] >> 4);
+
+    if (m_debug_enabled) {
+        std::cerr << "connect successful: valid handshake (router accepts messages up to "
+                << m_remote_max_message_length << " octets)" << std::endl;
+    }
+    m_connect.set_value();
+    receive_message();
 }
 
 template <class Socket>
 void wamp_rawsocket_transport<Socket>::receive_message()
 {
+    if (m_receive_paused) {
+        m_receive_deferred = true;
+        return;
+    }
+
     if (m_debug_enabled) {
         std::cerr << "RX preparing to receive message .." << std::endl;
     }
@@ -301,10 +534,11 @@ void wamp_rawsocket_transport<Socket>::receive_message()
     boost::asio::async_read(
         m_socket,
         boost::asio::buffer(&m_message_length, sizeof(m_message_length)),
-        bind(&wamp_rawsocket_transport<Socket>::receive_message_header,
-            this->shared_from_this(),
-            boost::asio::placeholders::error,
-            boost::asio::placeholders::bytes_transferred));
+        boost::asio::bind_executor(m_strand,
+            bind(&wamp_rawsocket_transport<Socket>::receive_message_header,
+                this->shared_from_this(),
+                boost::asio::placeholders::error,
+                boost::asio::placeholders::bytes_transferred)));
 }
 
 template <class Socket>
@@ -319,17 +553,32 @@ void wamp_rawsocket_transport<Socket>::receive_message_header(
             std::cerr << "RX message (" << m_message_length << " octets) ..." << std::endl;
         }
 
-        m_message_unpacker.reserve_buffer(m_message_length);
+        // Reject oversized frames before allocating anything for them. The
+        // peer was told our limit during the handshake, so this is a
+        // protocol violation and the connection cannot be recovered.
+        if (m_message_length > m_options.max_message_length()) {
+            if (m_debug_enabled) {
+                std::cerr << "RX message exceeds maximum length of "
+                        << m_options.max_message_length() << " octets" << std::endl;
+            }
+            fail_connection("incoming message exceeds the maximum message length");
+            return;
+        }
+
+        reserve_receive_buffer(m_message_length);
 
         boost::asio::async_read(
             m_socket,
-            boost::asio::buffer(m_message_unpacker.buffer(), m_message_length),
-            bind(&wamp_rawsocket_transport<Socket>::receive_message_body,
-                this->shared_from_this(),
-                boost::asio::placeholders::error,
-                boost::asio::placeholders::bytes_transferred));
+            boost::asio::buffer(m_receive_buffer.get(), m_message_length),
+            boost::asio::bind_executor(m_strand,
+                bind(&wamp_rawsocket_transport<Socket>::receive_message_body,
+                    this->shared_from_this(),
+                    boost::asio::placeholders::error,
+                    boost::asio::placeholders::bytes_transferred)));
         return;
     }
+
+    receive_error(error_code);
 }
 
 template <class Socket>
@@ -338,9 +587,7 @@ void wamp_rawsocket_transport<Socket>::receive_message_body(
         std::size_t /* bytes transferred */)
 {
     if (error_code) {
-        if (m_debug_enabled && error_code != boost::asio::error::operation_aborted) {
-            std::cerr << "Receive error: " << error_code << std::endl;
-        }
+        receive_error(error_code);
         return;
     }
 
@@ -348,26 +595,229 @@ void wamp_rawsocket_transport<Socket>::receive_message_body(
         std::cerr << "RX message received." << std::endl;
     }
 
-    if (m_handler) {
-        m_message_unpacker.buffer_consumed(m_message_length);
+    if (!m_handler) {
+        std::cerr << "RX message ignored: no handler attached" << std::endl;
+    } else if (m_message_length > 0) {
+        // Each frame carries exactly one message. Unpacking copies what it
+        // needs into the result's zone, so the receive buffer can be reused
+        // straight away.
         msgpack::unpacked result;
+        msgpack::unpack(result, m_receive_buffer.get(), m_message_length);
 
-        while (m_message_unpacker.next(result)) {
-            wamp_message::message_fields fields;
-            result.get().convert(fields);
+        wamp_message message(result.get(), std::move(result.zone()));
+        if (m_debug_enabled) {
+            std::cerr << "RX message: " << message << std::endl;
+        }
 
-            wamp_message message(std::move(fields), std::move(*(result.zone())));
-            if (m_debug_enabled) {
-                std::cerr << "RX message: " << message << std::endl;
-            }
+        m_handler->on_message(std::move(message));
+    }
 
-            m_handler->on_message(std::move(message));
+    if (m_receive_buffer_size > m_options.receive_buffer_shrink_threshold()) {
+        m_receive_buffer.reset();
+        m_receive_buffer_size = 0;
+    }
+
+    receive_message();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::reserve_receive_buffer(std::size_t length)
+{
+    if (length <= m_receive_buffer_size) {
+        return;
+    }
+
+    std::size_t size = m_options.initial_receive_buffer_size();
+    if (m_options.receive_buffer_growth() == wamp_rawsocket_options::buffer_growth::exact) {
+        size = std::max(size, length);
+    } else {
+        size = std::max<std::size_t>(std::max(size, m_receive_buffer_size), 1);
+        while (size < length) {
+            size *= 2;
         }
+        size = std::min<std::size_t>(size, m_options.max_message_length());
+    }
+
+    // The old contents are never needed, so there is nothing to copy.
+    m_receive_buffer.reset(new char[size]);
+    m_receive_buffer_size = size;
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::schedule_flush()
+{
+    if (m_flush_pending) {
+        return;
+    }
+
+    m_flush_pending = true;
+
+    if (m_batch_options.max_delay() == std::chrono::microseconds::zero()) {
+        boost::asio::post(m_strand,
+            bind(&wamp_rawsocket_transport<Socket>::flush_queued_messages,
+                this->shared_from_this()));
     } else {
-        std::cerr << "RX message ignored: no handler attached" << std::endl;
+        m_flush_timer.expires_from_now(m_batch_options.max_delay());
+        m_flush_timer.async_wait(boost::asio::bind_executor(m_strand,
+            bind(&wamp_rawsocket_transport<Socket>::flush_timer_handler,
+                this->shared_from_this(),
+                boost::asio::placeholders::error)));
     }
+}
 
-    receive_message();
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::flush_queued_messages()
+{
+    // The batch may already have gone out, either because it reached its
+    // byte budget or because it was picked up after an earlier write.
+    if (!m_flush_pending) {
+        return;
+    }
+
+    m_flush_pending = false;
+
+    if (m_write_queue.empty() && !m_send_queue.empty() && m_socket.is_open()) {
+        write_queued_messages();
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::flush_timer_handler(
+        const boost::system::error_code& error_code)
+{
+    if (error_code == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    flush_queued_messages();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::write_queued_messages()
+{
+    if (m_flush_pending) {
+        m_flush_pending = false;
+        m_flush_timer.cancel();
+    }
+
+    m_write_queue.swap(m_send_queue);
+    m_batch_statistics.record_batch(m_write_queue.size(), m_send_queue_bytes);
+    m_write_queue_bytes = m_send_queue_bytes;
+    m_send_queue_bytes = 0;
+
+    // Each message contributes its length prefix followed by its body so
+    // that the whole batch goes out in a single gathered write.
+    m_write_buffers.clear();
+    for (const auto& message : m_write_queue) {
+        m_write_buffers.push_back(
+                boost::asio::buffer(&message.m_length, sizeof(message.m_length)));
+        m_write_buffers.push_back(
+                boost::asio::buffer(message.m_buffer->data(), message.m_buffer->size()));
+    }
+
+    boost::asio::async_write(
+        m_socket,
+        m_write_buffers,
+        boost::asio::bind_executor(m_strand,
+            bind(&wamp_rawsocket_transport<Socket>::write_message_handler,
+                this->shared_from_this(),
+                boost::asio::placeholders::error,
+                boost::asio::placeholders::bytes_transferred)));
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::write_message_handler(
+        const boost::system::error_code& error_code,
+        std::size_t /* bytes transferred */)
+{
+    if (error_code) {
+        if (error_code == boost::asio::error::operation_aborted) {
+            // The socket was closed on purpose, so drop anything still waiting.
+            m_write_queue.clear();
+            m_send_queue.clear();
+            m_write_queue_bytes = 0;
+            m_send_queue_bytes = 0;
+            update_send_backpressure();
+            return;
+        }
+
+        if (m_debug_enabled) {
+            std::cerr << "Send error: " << error_code << std::endl;
+        }
+
+        fail_connection(error_code.message());
+        return;
+    }
+
+    m_write_queue.clear();
+    m_write_queue_bytes = 0;
+
+    if (!m_send_queue.empty()) {
+        write_queued_messages();
+    }
+
+    // Only notify once the next write is under way, since the handlers may
+    // well send more messages.
+    update_send_backpressure();
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::receive_error(const boost::system::error_code& error_code)
+{
+    // An aborted read means the socket was closed on purpose.
+    if (error_code == boost::asio::error::operation_aborted) {
+        return;
+    }
+
+    if (m_debug_enabled) {
+        std::cerr << "Receive error: " << error_code << std::endl;
+    }
+
+    fail_connection(error_code.message());
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::fail_connection(const std::string& reason)
+{
+    boost::system::error_code ignored;
+    m_socket.close(ignored);
+
+    if (m_flush_pending) {
+        m_flush_pending = false;
+        m_flush_timer.cancel();
+    }
+
+    // Nothing queued can be written any more.
+    m_write_queue.clear();
+    m_send_queue.clear();
+    m_write_queue_bytes = 0;
+    m_send_queue_bytes = 0;
+    update_send_backpressure();
+
+    // The handler stays attached until detach() is called, but it is told
+    // straight away so that it can fail whatever is waiting on the router.
+    if (m_handler && !m_handler_detached) {
+        m_handler_detached = true;
+        m_handler->on_detach(false, reason);
+    }
+}
+
+template <class Socket>
+void wamp_rawsocket_transport<Socket>::update_send_backpressure()
+{
+    std::size_t queued = queued_bytes();
+
+    if (!m_send_paused && queued >= m_high_watermark) {
+        m_send_paused = true;
+        if (m_pause_handler) {
+            m_pause_handler();
+        }
+    } else if (m_send_paused && queued <= m_low_watermark) {
+        m_send_paused = false;
+        if (m_resume_handler) {
+            m_resume_handler();
+        }
+    }
 }
 
 } // namespace autobahn
@@ -31,10 +31,13 @@
 #ifndef AUTOBAHN_WAMP_REGISTER_REQUEST_HPP
 #define AUTOBAHN_WAMP_REGISTER_REQUEST_HPP
 
+#include "wamp_completion_handler.hpp"
 #include "wamp_procedure.hpp"
 #include "wamp_registration.hpp"
 #include "boost_config.hpp"
 
+#include <cstddef>
+
 namespace autobahn {
 
 /// An outstanding wamp call.
@@ -43,16 +46,46 @@ class wamp_register_request
 public:
     wamp_register_request();
     wamp_register_request(const wamp_procedure& procedure);
+    wamp_register_request(const wamp_procedure& procedure,
+            std::size_t max_concurrency, std::size_t max_queue_depth);
     wamp_register_request(wamp_register_request&& other);
 
     const wamp_procedure& procedure() const;
+
+    /*!
+     * The concurrency limits of the procedure, see wamp_provide_options.
+     */
+    std::size_t max_concurrency() const;
+    std::size_t max_queue_depth() const;
+
     boost::promise<wamp_registration>& response();
     void set_procedure(wamp_procedure procedure) const;
     void set_response(const wamp_registration& registration);
 
+    /*!
+     * Fails the request, through the completion handler if there is one
+     * and through the promise otherwise.
+     */
+    template <typename Exception>
+    void set_exception(const Exception& exception);
+
+    /*!
+     * Fails the request with an exception captured by std::current_exception(),
+     * keeping its type.
+     */
+    void set_exception(std::exception_ptr exception);
+
+    /*!
+     * Completes the request through the given handler instead of the promise.
+     */
+    void set_completion_handler(const wamp_completion_handler<wamp_registration>& handler);
+
 private:
     wamp_procedure m_procedure;
+    std::size_t m_max_concurrency;
+    std::size_t m_max_queue_depth;
     boost::promise<wamp_registration> m_response;
+    wamp_completion_handler<wamp_registration> m_completion_handler;
 };
 
 } // namespace autobahn
@@ -32,19 +32,39 @@ namespace autobahn {
 
 inline wamp_register_request::wamp_register_request()
     : m_procedure()
+    , m_max_concurrency(0)
+    , m_max_queue_depth(0)
     , m_response()
+    , m_completion_handler()
 {
 }
 
 inline wamp_register_request::wamp_register_request(const wamp_procedure& procedure)
     : m_procedure(procedure)
+    , m_max_concurrency(0)
+    , m_max_queue_depth(0)
     , m_response()
+    , m_completion_handler()
+{
+}
+
+inline wamp_register_request::wamp_register_request(
+        const wamp_procedure& procedure,
+        std::size_t max_concurrency, std::size_t max_queue_depth)
+    : m_procedure(procedure)
+    , m_max_concurrency(max_concurrency)
+    , m_max_queue_depth(max_queue_depth)
+    , m_response()
+    , m_completion_handler()
 {
 }
 
 inline wamp_register_request::wamp_register_request(wamp_register_request&& other)
     : m_procedure(std::move(other.m_procedure))
+    , m_max_concurrency(other.m_max_concurrency)
+    , m_max_queue_depth(other.m_max_queue_depth)
     , m_response(std::move(other.m_response))
+    , m_completion_handler(std::move(other.m_completion_handler))
 {
 }
 
@@ -53,6 +73,16 @@ inline const wamp_procedure& wamp_register_request::procedure() const
     return m_procedure;
 }
 
+inline std::size_t wamp_register_request::max_concurrency() const
+{
+    return m_max_concurrency;
+}
+
+inline std::size_t wamp_register_request::max_queue_depth() const
+{
+    return m_max_queue_depth;
+}
+
 inline boost::promise<wamp_registration>& wamp_register_request::response()
 {
     return m_response;
@@ -60,7 +90,35 @@ inline boost::promise<wamp_registration>& wamp_register_request::response()
 
 inline void wamp_register_request::set_response(const wamp_registration& registration)
 {
-    m_response.set_value(registration);
+    if (m_completion_handler) {
+        m_completion_handler(nullptr, registration);
+    } else {
+        m_response.set_value(registration);
+    }
+}
+
+template <typename Exception>
+inline void wamp_register_request::set_exception(const Exception& exception)
+{
+    if (m_completion_handler) {
+        m_completion_handler(std::make_exception_ptr(exception), wamp_registration());
+    } else {
+        m_response.set_exception(boost::copy_exception(exception));
+    }
+}
+
+inline void wamp_register_request::set_exception(std::exception_ptr exception)
+{
+    if (m_completion_handler) {
+        m_completion_handler(exception, wamp_registration());
+    } else {
+        m_response.set_exception(detail::to_boost_exception(exception));
+    }
+}
+
+inline void wamp_register_request::set_completion_handler(const wamp_completion_handler<wamp_registration>& handler)
+{
+    m_completion_handler = handler;
 }
 
 } // namespace autobahn
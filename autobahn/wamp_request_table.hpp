@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_REQUEST_TABLE_HPP
+#define AUTOBAHN_WAMP_REQUEST_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A table of pending requests keyed by request id. Request ids are handed
+ * out in increasing order, so the table is a ring of slots indexed by the
+ * low bits of the id and an insert or lookup touches a single slot. The
+ * ring doubles whenever it becomes half full. A request that collides
+ * with one still outstanding from a full lap earlier is kept in an
+ * overflow map instead, which stays empty unless some requests remain
+ * pending for a very long time.
+ *
+ * Once the ring has grown to the number of requests in flight, inserting
+ * and removing requests does not allocate.
+ *
+ * @tparam T The pending request type, which must be default constructible
+ *           and movable.
+ */
+template <typename T>
+class wamp_request_table
+{
+public:
+    /*!
+     * Constructs an empty table.
+     *
+     * @param initial_capacity The initial number of slots, which is rounded
+     *                         up to a power of two.
+     */
+    explicit wamp_request_table(std::size_t initial_capacity = 64);
+
+    /*!
+     * Adds a pending request. Request ids must be non-zero and unique
+     * among the pending requests.
+     *
+     * @param request_id The request id.
+     * @param value The pending request.
+     */
+    void insert(uint64_t request_id, T value);
+
+    /*!
+     * Looks up a pending request.
+     *
+     * @param request_id The request id.
+     *
+     * @return The pending request, or null if there is none with that id.
+     */
+    T* find(uint64_t request_id);
+
+    /*!
+     * Removes a pending request and hands it to the caller.
+     *
+     * @param request_id The request id.
+     * @param value Assigned the pending request, if there was one.
+     *
+     * @return Whether there was a pending request with that id.
+     */
+    bool extract(uint64_t request_id, T& value);
+
+    /*!
+     * Removes a pending request.
+     *
+     * @param request_id The request id.
+     *
+     * @return Whether there was a pending request with that id.
+     */
+    bool erase(uint64_t request_id);
+
+    /*!
+     * Invokes a function for every pending request.
+     *
+     * @param function Invoked with the request id and the pending request.
+     */
+    template <typename Function>
+    void for_each(Function function);
+
+    /*!
+     * Removes all pending requests. The slots are kept for reuse.
+     */
+    void clear();
+
+    /*!
+     * The number of pending requests.
+     */
+    std::size_t size() const;
+
+    /*!
+     * Determines whether there are no pending requests.
+     */
+    bool empty() const;
+
+private:
+    struct slot
+    {
+        slot() : m_request_id(0), m_value() {}
+
+        /*!
+         * The id of the request in this slot, or zero if it is free.
+         */
+        uint64_t m_request_id;
+        T m_value;
+    };
+
+    slot& slot_for(uint64_t request_id);
+    void grow();
+
+private:
+    /*!
+     * The ring of slots, whose size is always a power of two.
+     */
+    std::vector<slot> m_slots;
+
+    /*!
+     * Pending requests whose slot was taken when they were inserted.
+     */
+    std::unordered_map<uint64_t, T> m_overflow;
+
+    /*!
+     * The number of pending requests held in the ring.
+     */
+    std::size_t m_num_slotted;
+};
+
+} // namespace autobahn
+
+#include "wamp_request_table.ipp"
+
+#endif // AUTOBAHN_WAMP_REQUEST_TABLE_HPP
@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+
+namespace autobahn {
+
+template <typename T>
+inline wamp_request_table<T>::wamp_request_table(std::size_t initial_capacity)
+    : m_slots()
+    , m_overflow()
+    , m_num_slotted(0)
+{
+    std::size_t capacity = 1;
+    while (capacity < initial_capacity) {
+        capacity <<= 1;
+    }
+
+    m_slots.resize(capacity);
+}
+
+template <typename T>
+inline void wamp_request_table<T>::insert(uint64_t request_id, T value)
+{
+    if ((m_num_slotted + 1) * 2 > m_slots.size()) {
+        grow();
+    }
+
+    slot& target = slot_for(request_id);
+    if (target.m_request_id == 0) {
+        target.m_request_id = request_id;
+        target.m_value = std::move(value);
+        ++m_num_slotted;
+    } else {
+        m_overflow[request_id] = std::move(value);
+    }
+}
+
+template <typename T>
+inline T* wamp_request_table<T>::find(uint64_t request_id)
+{
+    slot& target = slot_for(request_id);
+    if (target.m_request_id == request_id) {
+        return &target.m_value;
+    }
+
+    if (m_overflow.empty()) {
+        return nullptr;
+    }
+
+    auto itr = m_overflow.find(request_id);
+    return itr != m_overflow.end() ? &itr->second : nullptr;
+}
+
+template <typename T>
+inline bool wamp_request_table<T>::extract(uint64_t request_id, T& value)
+{
+    slot& target = slot_for(request_id);
+    if (target.m_request_id == request_id) {
+        value = std::move(target.m_value);
+        target.m_value = T();
+        target.m_request_id = 0;
+        --m_num_slotted;
+        return true;
+    }
+
+    if (m_overflow.empty()) {
+        return false;
+    }
+
+    auto itr = m_overflow.find(request_id);
+    if (itr == m_overflow.end()) {
+        return false;
+    }
+
+    value = std::move(itr->second);
+    m_overflow.erase(itr);
+
+    return true;
+}
+
+template <typename T>
+inline bool wamp_request_table<T>::erase(uint64_t request_id)
+{
+    T value;
+    return extract(request_id, value);
+}
+
+template <typename T>
+template <typename Function>
+inline void wamp_request_table<T>::for_each(Function function)
+{
+    for (auto& current : m_slots) {
+        if (current.m_request_id != 0) {
+            function(current.m_request_id, current.m_value);
+        }
+    }
+
+    for (auto& current : m_overflow) {
+        function(current.first, current.second);
+    }
+}
+
+template <typename T>
+inline void wamp_request_table<T>::clear()
+{
+    for (auto& current : m_slots) {
+        current.m_request_id = 0;
+        current.m_value = T();
+    }
+
+    m_overflow.clear();
+    m_num_slotted = 0;
+}
+
+template <typename T>
+inline std::size_t wamp_request_table<T>::size() const
+{
+    return m_num_slotted + m_overflow.size();
+}
+
+template <typename T>
+inline bool wamp_request_table<T>::empty() const
+{
+    return size() == 0;
+}
+
+template <typename T>
+inline typename wamp_request_table<T>::slot& wamp_request_table<T>::slot_for(uint64_t request_id)
+{
+    return m_slots[static_cast<std::size_t>(request_id) & (m_slots.size() - 1)];
+}
+
+template <typename T>
+inline void wamp_request_table<T>::grow()
+{
+    std::vector<slot> slots(m_slots.size() * 2);
+    std::swap(m_slots, slots);
+
+    std::unordered_map<uint64_t, T> overflow;
+    std::swap(m_overflow, overflow);
+
+    m_num_slotted = 0;
+
+    // Moving everything into the larger ring also gives overflowed requests
+    // another chance at getting a slot of their own.
+    for (auto& current : slots) {
+        if (current.m_request_id != 0) {
+            insert(current.m_request_id, std::move(current.m_value));
+        }
+    }
+
+    for (auto& current : overflow) {
+        insert(current.first, std::move(current.second));
+    }
+}
+
+} // namespace autobahn
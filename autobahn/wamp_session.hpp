@@ -31,28 +31,43 @@
 #ifndef AUTOBAHN_SESSION_HPP
 #define AUTOBAHN_SESSION_HPP
 
+#include "wamp_buffer_pool.hpp"
 #include "wamp_call_options.hpp"
 #include "wamp_call_result.hpp"
+#include "wamp_completion.hpp"
+#include "wamp_completion_handler.hpp"
 #include "wamp_event_handler.hpp"
+#include "wamp_invocation_statistics.hpp"
 #include "wamp_message.hpp"
+#include "wamp_mpsc_queue.hpp"
 #include "wamp_procedure.hpp"
+#include "wamp_publication.hpp"
 #include "wamp_publish_options.hpp"
+#include "wamp_request_table.hpp"
+#include "wamp_strand.hpp"
 #include "wamp_subscribe_options.hpp"
+#include "wamp_subscription_table.hpp"
+#include "wamp_timer_wheel.hpp"
 #include "wamp_transport_handler.hpp"
 #include "boost_config.hpp"
 
 #include <boost/asio.hpp>
+#include <boost/optional.hpp>
 
 #include <msgpack/object.hpp>
 
+#include <chrono>
 #include <cstdint>
+#include <deque>
 #include <functional>
+#include <limits>
 #include <istream>
 #include <ostream>
 #include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -86,6 +101,9 @@ event at the router, which in turn will dispatch the event to all eligible and
 authorized subscribes to the topic.
  */
 
+/// Handler type for use with wamp_session::set_error_handler
+typedef std::function<void(const std::exception&)> wamp_error_handler;
+
 /// Representation of a WAMP session.
 class wamp_session :
         public wamp_transport_handler,
@@ -96,6 +114,11 @@ public:
     /*!
      * Create a new WAMP session.
      *
+     * The session runs all of its handlers on the strand of the transport it
+     * is attached to, so the io service may be run from several threads. The
+     * transport must be attached before the session is used from more than
+     * one thread.
+     *
      * \param io_service The io service to drive event dispatching.
      * \param debug_enabled Whether or not to run in debug mode.
      */
@@ -132,6 +155,23 @@ public:
             const std::vector<std::string>& authmethods = std::vector<std::string>(),
             const std::string& authid = "");
 
+    /*!
+     * Join a realm with this session, completing through an asio completion token
+     * instead of a future, see async_call().
+     *
+     * \param realm The realm to join on the WAMP router connected to.
+     * \param authmethods The authentication methods to announce.
+     * \param authid The username or maybe an other identifier for the user to join.
+     * \param token The completion token, invoked with the session ID.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, uint64_t))
+    async_join(
+            const std::string& realm,
+            const std::vector<std::string>& authmethods,
+            const std::string& authid,
+            CompletionToken&& token);
+
     /*!
      * Leave the realm.
      *
@@ -141,16 +181,47 @@ public:
     boost::future<std::string> leave(
             const std::string& reason = std::string("wamp.error.close_realm"));
 
+    /*!
+     * Leave the realm, completing through an asio completion token instead of
+     * a future, see async_call().
+     *
+     * \param reason A WAMP URI providing a reason for leaving.
+     * \param token The completion token, invoked with the reason sent by the peer.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, std::string))
+    async_leave(const std::string& reason, CompletionToken&& token);
+
+    /*!
+     * Determines whether the transport can take more outbound messages
+     * without exceeding its high watermark. Messages sent while the session
+     * is not writable are still queued, so callers producing data faster than
+     * the peer consumes it should wait for the session to become writable.
+     *
+     * \return Whether or not the session is writable.
+     */
+    bool is_writable() const;
+
+    /*!
+     * Waits for the transport's outbound queue to drain below its low
+     * watermark.
+     *
+     * \return A future that resolves once the session is writable, or
+     *         straight away if it already is.
+     */
+    boost::future<void> wait_until_writable();
+
     /*!
      * \ingroup PUB
      * Publish an event with empty payload to a topic.
      *
      *
      * \param topic The URI of the topic to publish to.
-     * \return A future that resolves once the the topic has been published to.
+     * \return A future that resolves once the the topic has been published to, with the
+     *         publication id if the router was asked to acknowledge the publication.
      */
-    boost::future<void> publish(const std::string& topic,
-                                const wamp_publish_options& options = wamp_publish_options());
+    boost::future<wamp_publication> publish(const std::string& topic,
+                                            const wamp_publish_options& options = wamp_publish_options());
 
     /*!
      * \ingroup PUB
@@ -158,11 +229,12 @@ public:
      *
      * \param topic The URI of the topic to publish to.
      * \param arguments The positional payload for the event.
-     * \return A future that resolves once the the topic has been published to.
+     * \return A future that resolves once the the topic has been published to, with the
+     *         publication id if the router was asked to acknowledge the publication.
      */
     template <typename List>
-    boost::future<void> publish(const std::string& topic, const List& arguments,
-                                const wamp_publish_options& options = wamp_publish_options());
+    boost::future<wamp_publication> publish(const std::string& topic, const List& arguments,
+                                            const wamp_publish_options& options = wamp_publish_options());
 
     /*!
      * \ingroup PUB
@@ -171,18 +243,144 @@ public:
      * \param topic The URI of the topic to publish to.
      * \param arguments The positional payload for the event.
      * \param kw_arguments The keyword payload for the event.
-     * \return A future that resolves once the the topic has been published to.
+     * \return A future that resolves once the the topic has been published to, with the
+     *         publication id if the router was asked to acknowledge the publication.
+     */
+    template <typename List, typename Map>
+    boost::future<wamp_publication> publish(
+            const std::string& topic,
+            const List& arguments,
+            const Map& kw_arguments,
+            const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with empty payload to a topic, completing through an asio
+     * completion token instead of a future, see async_call().
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param options The options to publish with.
+     * \param token The completion token, invoked with the publication.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_publication))
+    async_publish(
+            const std::string& topic,
+            const wamp_publish_options& options,
+            CompletionToken&& token);
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with positional payload to a topic, completing through an
+     * asio completion token instead of a future.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param options The options to publish with.
+     * \param token The completion token, invoked with the publication.
+     */
+    template <typename List, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_publication))
+    async_publish(
+            const std::string& topic,
+            const List& arguments,
+            const wamp_publish_options& options,
+            CompletionToken&& token);
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with both positional and keyword payload to a topic,
+     * completing through an asio completion token instead of a future.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
+     * \param options The options to publish with.
+     * \param token The completion token, invoked with the publication.
+     */
+    template <typename List, typename Map, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_publication))
+    async_publish(
+            const std::string& topic,
+            const List& arguments,
+            const Map& kw_arguments,
+            const wamp_publish_options& options,
+            CompletionToken&& token);
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with empty payload to a topic without waiting for the outcome.
+     *
+     * Unlike publish(), no future is set up, so once the session's buffers have warmed
+     * up nothing is allocated. Failures to send the event are only reported through the
+     * session's error handler. Acknowledgement cannot be asked for.
+     *
+     * \param topic The URI of the topic to publish to.
+     */
+    void publish_nowait(const std::string& topic,
+                        const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with positional payload to a topic without waiting for the outcome.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     */
+    template <typename List>
+    void publish_nowait(const std::string& topic, const List& arguments,
+                        const wamp_publish_options& options = wamp_publish_options());
+
+    /*!
+     * \ingroup PUB
+     * Publish an event with both positional and keyword payload to a topic without
+     * waiting for the outcome.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
      */
     template <typename List, typename Map>
-    boost::future<void> publish(
+    void publish_nowait(
             const std::string& topic,
             const List& arguments,
             const Map& kw_arguments,
             const wamp_publish_options& options = wamp_publish_options());
 
+    /*!
+     * \ingroup PUB
+     * Publish a batch of events in one go.
+     *
+     * Each element of the range is a tuple of (topic, arguments, keyword arguments,
+     * options), the same as the parameters to publish(). Since options can't be copied,
+     * the options element would usually be a reference, for example std::cref(options).
+     * The events are published in the order given and handed to the transport
+     * together, so that they go out in a single write where the transport allows it
+     * rather than one write per event. Acknowledgement cannot be asked for.
+     *
+     * \param events The events to publish.
+     * \return A future that resolves once every event in the batch has been sent,
+     *         or fails if the batch could not be sent.
+     */
+    template <typename Range>
+    boost::future<void> publish_batch(const Range& events);
+
+    /*!
+     * Sets the handler for errors that cannot be reported through a future, such
+     * as a failure to send an event published with publish_nowait(). The handler
+     * is invoked on the io service. Set it before the session is used.
+     *
+     * \param handler The handler to report errors to.
+     */
+    void set_error_handler(const wamp_error_handler& handler);
+
     /*!
      * Subscribe a handler to a topic to receive events.
      *
+     * Handlers subscribed to the same topic with the same match policy share
+     * a single subscription at the router: only the first one sends a
+     * SUBSCRIBE, and the rest are added locally once it has been confirmed.
+     *
      * \param topic The URI of the topic to subscribe to.
      * \param handler The handler that will receive events under the subscription.
      * \param options The options to pass in the subscribe request to the router.
@@ -193,9 +391,35 @@ public:
             const wamp_event_handler& handler,
             const wamp_subscribe_options& options = wamp_subscribe_options());
 
+    /*!
+     * Subscribe a handler to a topic to receive events, completing through an asio
+     * completion token instead of a future.
+     *
+     * The token may be a plain callback taking (std::exception_ptr, wamp_subscription),
+     * boost::asio::use_future or any other asio completion token. A callback is invoked
+     * on its associated executor, or on the session's io service if it has none.
+     *
+     * \param topic The URI of the topic to subscribe to.
+     * \param handler The handler that will receive events under the subscription.
+     * \param options The options to pass in the subscribe request to the router.
+     * \param token The completion token for the subscribe request.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_subscription))
+    async_subscribe(
+            const std::string& topic,
+            const wamp_event_handler& handler,
+            const wamp_subscribe_options& options,
+            CompletionToken&& token);
+
     /*!
      * Unubscribe a handler to previously subscribed topic.
      *
+     * Only the handler the subscription was returned for is removed. The
+     * router subscription is released once its last local handler has been
+     * unsubscribed, and until then the future resolves without a round trip.
+     * A subscription constructed from a bare id removes all of its handlers.
+     *
      * \param subscription The subscription to unsubscribe from.
      * \return A future that resolves to the unsubscribed response.
      */
@@ -241,6 +465,61 @@ public:
             const List& arguments, const Map& kw_arguments,
             const wamp_call_options& options = wamp_call_options());
 
+    /*!
+     * Calls a remote procedure with no arguments, completing through an asio
+     * completion token instead of a future.
+     *
+     * The token may be a plain callback taking (std::exception_ptr, wamp_call_result),
+     * boost::asio::use_future or any other asio completion token. A callback is invoked
+     * on its associated executor, or on the session's io service if it has none. The
+     * options are copied, so they need not outlive a token that defers starting the call.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param options The options to pass in the call to the router.
+     * \param token The completion token for the call.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_call_result))
+    async_call(
+            const std::string& procedure,
+            const wamp_call_options& options,
+            CompletionToken&& token);
+
+    /*!
+     * Calls a remote procedure with positional arguments, completing through an
+     * asio completion token instead of a future.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \param token The completion token for the call.
+     */
+    template <typename List, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_call_result))
+    async_call(
+            const std::string& procedure,
+            const List& arguments,
+            const wamp_call_options& options,
+            CompletionToken&& token);
+
+    /*!
+     * Calls a remote procedure with positional and keyword arguments, completing
+     * through an asio completion token instead of a future.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param kw_arguments The keyword arguments for the call.
+     * \param options The options to pass in the call to the router.
+     * \param token The completion token for the call.
+     */
+    template <typename List, typename Map, typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_call_result))
+    async_call(
+            const std::string& procedure,
+            const List& arguments, const Map& kw_arguments,
+            const wamp_call_options& options,
+            CompletionToken&& token);
+
     /*!
      * Register a procedure that can be called remotely.
      *
@@ -254,6 +533,27 @@ public:
             const wamp_procedure& procedure,
             const provide_options& options = provide_options());
 
+    /*!
+     * Register a procedure that can be called remotely, completing through an
+     * asio completion token instead of a future.
+     *
+     * The token may be a plain callback taking (std::exception_ptr, wamp_registration),
+     * boost::asio::use_future or any other asio completion token. A callback is invoked
+     * on its associated executor, or on the session's io service if it has none.
+     *
+     * \param uri The URI associated with the procedure.
+     * \param procedure The procedure to be exposed as a remotely callable procedure.
+     * \param options Options for registering the procedure.
+     * \param token The completion token for the registration.
+     */
+    template <typename CompletionToken>
+    BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_registration))
+    async_provide(
+            const std::string& uri,
+            const wamp_procedure& procedure,
+            const provide_options& options,
+            CompletionToken&& token);
+
     /*!
     * Unregister a handler to previosly registered service.
     *
@@ -262,6 +562,16 @@ public:
     */
     boost::future<void> unprovide(const wamp_registration& registration);
 
+    /*!
+     * The counters of a registered procedure's invocations. Like the rest of
+     * the session's state they are updated on its strand, so read them from
+     * there when the io service is run by several threads.
+     *
+     * \param registration The registration of the procedure.
+     * \return The counters, which are all zero for an unknown registration.
+     */
+    wamp_invocation_statistics invocation_statistics(const wamp_registration& registration) const;
+
     /*!
      * Function called by the session when authenticating. It always has to be
      * re-implemented (if authentication is part of the system).
@@ -318,16 +628,50 @@ private:
     void process_abort(wamp_message&& message);
     void process_challenge(wamp_message&& message);
     void process_call_result(wamp_message&& message);
+    void process_published(wamp_message&& message);
     void process_subscribed(wamp_message&& message);
     void process_unsubscribed(wamp_message&& message);
     void process_event(wamp_message&& message);
     void process_registered(wamp_message&& message);
     void process_unregistered(wamp_message&& message);
     void process_invocation(wamp_message&& message);
+    void process_interrupt(wamp_message&& message);
+
+    // A registered procedure, along with the invocations waiting for one of
+    // its running invocations to finish. Interrupted invocations are answered
+    // right away but only leave the queue once they reach its front, so the
+    // queue may be longer than m_statistics.queued().
+    struct wamp_registered_procedure
+    {
+        wamp_procedure m_procedure;
+        std::size_t m_max_concurrency = 0;
+        std::size_t m_max_queue_depth = 0;
+        std::deque<wamp_invocation> m_queue;
+        wamp_invocation_statistics m_statistics;
+    };
+
+    // An invocation that has yet to send its final reply.
+    struct wamp_pending_invocation
+    {
+        std::weak_ptr<wamp_invocation_impl> m_invocation;
+        uint64_t m_registration_id = 0;
+
+        // Whether the invocation is still waiting in its registration's queue.
+        bool m_queued = false;
+    };
+
+    // Invocation admission
+    wamp_invocation_impl::send_result_fn make_send_result_fn(uint64_t request_id);
+    void admit_invocation(uint64_t registration_id, wamp_registered_procedure& registered, const wamp_invocation& invocation);
+    void complete_invocation(uint64_t request_id);
+    void finish_invocation(uint64_t registration_id);
+    void send_invocation_error(uint64_t request_id, const std::string& error_uri);
     void process_goodbye(wamp_message&& message);
 
     // Transmitting/receiving messages
     void send_message(wamp_message&& message, bool session_established = true);
+    void send_messages(std::vector<wamp_message>&& messages);
+    void check_sendable(bool session_established);
     void receive_message();
 
     void got_handshake_reply(const boost::system::error_code& error);
@@ -335,13 +679,137 @@ private:
     void got_message_body(const boost::system::error_code& error);
     void got_message(wamp_message&& message);
 
+    // Requests submitted from any thread, sent from the io service
+    struct wamp_submission
+    {
+        wamp_message m_message;
+        uint64_t m_request_id = 0;
+
+        // The time a call may take before it is failed locally, if any.
+        std::chrono::milliseconds m_timeout = std::chrono::milliseconds::zero();
+
+        // Set for a publication, fulfilled once the message has been sent,
+        // or tracked until the router acknowledges it.
+        std::shared_ptr<wamp_completion<wamp_publication>> m_published;
+        bool m_acknowledge = false;
+
+        // Set for a call, tracked once the message has been sent.
+        std::shared_ptr<wamp_call> m_call;
+
+        // Set for a subscription, tracked once the message has been sent.
+        std::shared_ptr<wamp_subscribe_request> m_subscribe_request;
+
+        // Set for a batch of publications, which are sent in place of the
+        // message and fulfilled once they have all been sent.
+        std::vector<wamp_message> m_batch;
+        std::shared_ptr<boost::promise<void>> m_batch_sent;
+    };
+
+    // Initiating function for the operations taking a completion token,
+    // which starts the operation with the handler adapted to the session.
+    template <typename Result>
+    struct initiation
+    {
+        template <typename Handler, typename Start>
+        void operator()(Handler&& handler, const Start& start) const;
+
+        std::shared_ptr<wamp_session> m_session;
+    };
+
+    void start_join(const std::string& realm, const std::vector<std::string>& authentication_methods,
+            const std::string& authentication_id, const std::shared_ptr<wamp_completion<uint64_t>>& joined);
+    void start_leave(const std::string& reason, const std::shared_ptr<wamp_completion<std::string>>& left);
+
+    void submit_publish(uint64_t request_id, wamp_message&& message,
+            bool acknowledge, const std::shared_ptr<wamp_completion<wamp_publication>>& published);
+    void submit_call(uint64_t request_id, wamp_message&& message,
+            const std::chrono::milliseconds& timeout, const wamp_progress_handler& progress_handler,
+            const wamp_cancellation_token* cancellation_token, const std::shared_ptr<wamp_call>& call);
+    void submit_subscribe(uint64_t request_id, wamp_message&& message,
+            const std::shared_ptr<wamp_subscribe_request>& subscribe_request);
+    void submit_register(uint64_t request_id, const std::shared_ptr<wamp_message>& message,
+            const std::shared_ptr<wamp_register_request>& register_request);
+
+    // Local subscriptions sharing a router subscription
+    bool join_topic_subscription(uint64_t request_id,
+            const std::shared_ptr<wamp_subscribe_request>& subscribe_request);
+    void confirm_topic_subscription(uint64_t request_id,
+            const std::shared_ptr<wamp_subscribe_request>& subscribe_request, uint64_t subscription_id);
+    template <typename Exception>
+    void fail_topic_subscription(
+            const std::shared_ptr<wamp_subscribe_request>& subscribe_request, const Exception& exception);
+    void release_topic_subscription(uint64_t subscription_id);
+    void reset_subscriptions();
+
+    // Messages sent directly drain the queue first so that they never
+    // overtake anything submitted earlier.
+    void submit(wamp_submission&& submission);
+    void schedule_submissions();
+    void process_submissions();
+    std::size_t drain_submissions(std::size_t max_submissions);
+    void report_error(const std::exception& e);
+
+    // Fails everything still waiting on the router once the transport is gone.
+    void fail_pending_requests();
+    template <typename Request, typename Function>
+    static void fail_requests(wamp_request_table<Request>& requests, Function fail);
+
+    // The most submissions sent by a single turn of the io service.
+    static const std::size_t max_submissions_per_drain = 256;
+
+    // Call timeouts
+    void schedule_call_timeout(wamp_call& call, uint64_t request_id, const std::chrono::milliseconds& timeout);
+    void arm_call_timer();
+    void expire_call(uint64_t request_id);
+
+    // Call cancellation
+    void watch_cancellation(const wamp_cancellation_token& cancellation_token, uint64_t request_id);
+    void cancel_call(uint64_t request_id, wamp_cancel_mode mode);
+    void send_cancel(uint64_t request_id, wamp_cancel_mode mode);
+
+    static bool has_feature(const msgpack::object& details, const std::string& role, const std::string& feature);
+
+    // Backpressure from the transport
+    void on_transport_paused();
+    void on_transport_resumed();
+
     bool m_debug_enabled;
 
     boost::asio::io_service& m_io_service;
 
+    // The strand the session's state is touched on. It's shared with the
+    // transport once one is attached, so that messages received from the
+    // transport don't need a second hop.
+    wamp_strand m_strand;
+
     // The transport this session runs on.
     std::shared_ptr<wamp_transport> m_transport;
 
+    // The handlers the transport had before the session attached, which the
+    // session's own pause and resume handlers chain to.
+    std::function<void()> m_chained_pause_handler;
+    std::function<void()> m_chained_resume_handler;
+
+    // The transport's pool of buffers for outbound messages, if it has one.
+    std::shared_ptr<wamp_buffer_pool> m_buffer_pool;
+
+    // Whether or not the transport's outbound queue is below its high watermark.
+    std::atomic<bool> m_writable;
+
+    // Promises to be fulfilled once the transport becomes writable again.
+    std::vector<std::shared_ptr<boost::promise<void>>> m_writable_waiters;
+
+    // Publications, calls and subscriptions waiting to be sent. Any thread
+    // may submit to the queue without taking a lock, and the io service
+    // drains it in batches.
+    wamp_mpsc_queue<wamp_submission> m_submissions;
+
+    // Whether or not a drain of the submission queue has been scheduled.
+    std::atomic<bool> m_submissions_scheduled;
+
+    // Reports errors that have no future to go to.
+    wamp_error_handler m_error_handler;
+
     // Last request ID of outgoing WAMP requests.
     std::atomic<uint64_t> m_request_id;
 
@@ -351,13 +819,14 @@ private:
     // Synchronization for dealing with starting the session.
     boost::promise<void> m_session_start;
 
-    // Future to be fired when session was joined.
-    boost::promise<uint64_t> m_session_join;
+    // Completed when the session was joined, set while joining.
+    std::shared_ptr<wamp_completion<uint64_t>> m_session_join;
 
     // Whether or not we have already sent a goodbye when leaving the session.
     bool m_goodbye_sent;
 
-    boost::promise<std::string> m_session_leave;
+    // Completed when the peer replies to our goodbye, set while leaving.
+    std::shared_ptr<wamp_completion<std::string>> m_session_leave;
 
     // Set to true when the session is stopped.
     bool m_running;
@@ -368,32 +837,78 @@ private:
     //////////////////////////////////////////////////////////////////////////////////////
     // Caller
 
+    // Deadlines of pending calls that were made with a timeout. Declared
+    // ahead of the calls, which unlink themselves when they are destroyed.
+    wamp_timer_wheel m_call_timeouts;
+
+    // Wakes the call timeout wheel up whenever it next has work to do.
+    boost::asio::steady_timer m_call_timer;
+
+    // When the call timer is due to fire, or the latest representable time
+    // if it isn't waiting.
+    wamp_timer_wheel::clock::time_point m_call_timer_expiry;
+
+    // Whether or not the router accepts CANCEL for timed out calls.
+    bool m_router_call_canceling;
+
     // Track pending calls by request id.
-    std::map<uint64_t /*request id*/, std::shared_ptr<wamp_call>> m_calls;
+    wamp_request_table<std::shared_ptr<wamp_call>> m_calls;
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    // Publisher
+
+    // Publications waiting to be acknowledged by request id.
+    wamp_request_table<std::shared_ptr<wamp_completion<wamp_publication>>> m_publish_requests;
 
     //////////////////////////////////////////////////////////////////////////////////////
     // Subscriber
 
     // Pending subscribe requests by request id.
-    std::map<uint64_t /*request id*/, std::shared_ptr<wamp_subscribe_request>> m_subscribe_requests;
+    wamp_request_table<std::shared_ptr<wamp_subscribe_request>> m_subscribe_requests;
 
     // Pending unsubscribe requests by request id.
-    std::map<uint64_t /*request id*/, std::shared_ptr<wamp_unsubscribe_request>> m_unsubscribe_requests;
+    wamp_request_table<std::shared_ptr<wamp_unsubscribe_request>> m_unsubscribe_requests;
+
+    // Event handlers by subscription id, each tagged with the request id
+    // of the subscribe that added it.
+    wamp_subscription_table m_subscription_handlers;
 
-    // Event handlers by subscription id.
-    std::multimap<uint64_t /*subscription id*/, wamp_event_handler> m_subscription_handlers;
+    // A router subscription shared by all local handlers subscribed to the
+    // same topic with the same match policy.
+    struct wamp_topic_subscription
+    {
+        // Zero until the router has confirmed the subscription.
+        uint64_t m_subscription_id = 0;
+
+        // Subscribe requests that arrived while the subscription was still
+        // pending, by request id. They complete along with the first one.
+        std::vector<std::pair<uint64_t, std::shared_ptr<wamp_subscribe_request>>> m_waiting;
+    };
+
+    typedef std::map<std::pair<std::string, std::string>, wamp_topic_subscription> wamp_topic_subscriptions;
+
+    // Router subscriptions by match policy and topic.
+    wamp_topic_subscriptions m_topic_subscriptions;
+
+    // Confirmed router subscriptions by subscription id.
+    std::map<uint64_t, wamp_topic_subscriptions::iterator> m_subscription_topics;
 
     //////////////////////////////////////////////////////////////////////////////////////
     // Callee
 
-    // Map of outstanding WAMP register requests (request ID -> register request).
-    std::map<uint64_t, std::shared_ptr<wamp_register_request>> m_register_requests;
+    // Table of outstanding WAMP register requests (request ID -> register request).
+    wamp_request_table<std::shared_ptr<wamp_register_request>> m_register_requests;
+
+    // Table of outstanding WAMP unregister requests (request ID -> unregister request).
+    wamp_request_table<std::shared_ptr<wamp_unregister_request>> m_unregister_requests;
 
-    // Map of outstanding WAMP unregister requests (request ID -> unregister request).
-    std::map<uint64_t, std::shared_ptr<wamp_unregister_request>> m_unregister_requests;
+    // Invocations that have yet to send their final reply, so that they can
+    // be interrupted (INVOCATION request ID -> invocation). Replies for
+    // invocations missing from here are dropped.
+    wamp_request_table<wamp_pending_invocation> m_invocations;
 
     // Map of registered procedures (registration ID -> procedure)
-    std::map<uint64_t, wamp_procedure> m_procedures;
+    std::map<uint64_t, wamp_registered_procedure> m_procedures;
 
     // Welcome details
     std::unordered_map<std::string, msgpack::object> m_welcome_details;
@@ -29,7 +29,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "exceptions.hpp"
+#include "wamp_arguments.hpp"
 #include "wamp_call.hpp"
+#include "wamp_dispatch.hpp"
 #include "wamp_event.hpp"
 #include "wamp_invocation.hpp"
 #include "wamp_message.hpp"
@@ -53,9 +55,11 @@
 #endif
 
 #include <boost/system/error_code.hpp>
+#include <algorithm>
 #include <cstdint>
 #include <exception>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <stdlib.h>
 
@@ -66,11 +70,22 @@ inline wamp_session::wamp_session(
         bool debug_enabled)
     : m_debug_enabled(debug_enabled)
     , m_io_service(io_service)
+    , m_strand(io_service.get_executor())
     , m_transport()
+    , m_buffer_pool()
+    , m_writable(true)
+    , m_writable_waiters()
+    , m_submissions()
+    , m_submissions_scheduled(false)
+    , m_error_handler()
     , m_request_id(0)
     , m_session_id(0)
     , m_goodbye_sent(false)
     , m_running(false)
+    , m_call_timeouts()
+    , m_call_timer(io_service)
+    , m_call_timer_expiry(wamp_timer_wheel::clock::time_point::max())
+    , m_router_call_canceling(false)
 {
 }
 
@@ -82,7 +97,7 @@ inline boost::future<void> wamp_session::start()
 {
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 
-    m_io_service.dispatch([=]() {
+    boost::asio::dispatch(m_strand, [=]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
@@ -109,7 +124,7 @@ inline boost::future<void> wamp_session::stop()
 {
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 
-    m_io_service.dispatch([=]() {
+    boost::asio::dispatch(m_strand, [=]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
@@ -121,7 +136,7 @@ inline boost::future<void> wamp_session::stop()
         }
 
         if (!m_transport) {
-            m_session_start.set_exception(boost::copy_exception(no_transport_error()));
+            m_session_stop.set_exception(boost::copy_exception(no_transport_error()));
             return;
         }
 
@@ -141,18 +156,51 @@ inline boost::future<uint64_t> wamp_session::join(
         const std::string& realm,
         const std::vector<std::string>& authentication_methods,
         const std::string& authentication_id)
+{
+    auto joined = std::make_shared<wamp_completion<uint64_t>>();
+    auto result = joined->get_future();
+    start_join(realm, authentication_methods, authentication_id, joined);
+
+    return result;
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, uint64_t))
+wamp_session::async_join(
+        const std::string& realm,
+        const std::vector<std::string>& authentication_methods,
+        const std::string& authentication_id,
+        CompletionToken&& token)
+{
+    auto start = [this, realm, authentication_methods, authentication_id](
+            const wamp_completion_handler<uint64_t>& handler) {
+        start_join(realm, authentication_methods, authentication_id,
+                std::make_shared<wamp_completion<uint64_t>>(handler));
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, uint64_t)>(
+            initiation<uint64_t>{this->shared_from_this()}, token, start);
+}
+
+inline void wamp_session::start_join(
+        const std::string& realm,
+        const std::vector<std::string>& authentication_methods,
+        const std::string& authentication_id,
+        const std::shared_ptr<wamp_completion<uint64_t>>& joined)
 {
     msgpack::zone zone;
     std::unordered_map<std::string, msgpack::object> roles;
 
     std::unordered_map<std::string, bool> caller_features;
     caller_features["call_timeout"] = true;
+    caller_features["call_canceling"] = true;
     std::unordered_map<std::string, msgpack::object> caller;
     caller["features"] = msgpack::object(caller_features, zone);
     roles["caller"] = msgpack::object(caller, zone);
 
     std::unordered_map<std::string, bool> callee_features;
     callee_features["call_timeout"] = true;
+    callee_features["call_canceling"] = true;
     std::unordered_map<std::string, msgpack::object> callee;
     callee["features"] = msgpack::object(callee_features, zone);
     roles["callee"] = msgpack::object(callee, zone);
@@ -175,28 +223,49 @@ inline boost::future<uint64_t> wamp_session::join(
 
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 
-    m_io_service.dispatch([=]() {
+    boost::asio::dispatch(m_strand, [=]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
-        if (m_session_id) {
-            m_session_join.set_exception(boost::copy_exception(protocol_error("session already joined")));
+        if (m_session_id || m_session_join) {
+            joined->set_exception(protocol_error("session already joined"));
             return;
         }
 
         try {
             send_message(std::move(*message), false);
-        } catch (const std::exception& e) {
-            m_session_join.set_exception(boost::copy_exception(e));
+            m_session_join = joined;
+        } catch (const std::exception&) {
+            joined->set_exception(std::current_exception());
         }
     });
-
-    return m_session_join.get_future();
 }
 
 inline boost::future<std::string> wamp_session::leave(const std::string& reason)
+{
+    auto left = std::make_shared<wamp_completion<std::string>>();
+    auto result = left->get_future();
+    start_leave(reason, left);
+
+    return result;
+}
+
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, std::string))
+wamp_session::async_leave(const std::string& reason, CompletionToken&& token)
+{
+    auto start = [this, reason](const wamp_completion_handler<std::string>& handler) {
+        start_leave(reason, std::make_shared<wamp_completion<std::string>>(handler));
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, std::string)>(
+            initiation<std::string>{this->shared_from_this()}, token, start);
+}
+
+inline void wamp_session::start_leave(
+        const std::string& reason, const std::shared_ptr<wamp_completion<std::string>>& left)
 {
     auto message = std::make_shared<wamp_message>(3);
     message->set_field(0, static_cast<int>(message_type::GOODBYE));
@@ -205,123 +274,266 @@ inline boost::future<std::string> wamp_session::leave(const std::string& reason)
 
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 
-    m_io_service.dispatch([=]() {
+    boost::asio::dispatch(m_strand, [=]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
         if (m_goodbye_sent) {
-            m_session_leave.set_exception(boost::copy_exception(protocol_error("goodbye already sent")));
+            left->set_exception(protocol_error("goodbye already sent"));
+            return;
         }
 
+        // Anything submitted before leaving goes out ahead of the goodbye.
+        drain_submissions(std::numeric_limits<std::size_t>::max());
+
         try {
             send_message(std::move(*message), false);
             m_goodbye_sent = true;
-        } catch (const std::exception& e) {
-            m_session_leave.set_exception(boost::copy_exception(e));
+            m_session_leave = left;
+        } catch (const std::exception&) {
+            left->set_exception(std::current_exception());
         }
 
         m_session_id = 0;
+        reset_subscriptions();
     });
-
-    return m_session_leave.get_future();
 }
 
-inline boost::future<void> wamp_session::publish(const std::string& topic,const wamp_publish_options& options)
+inline bool wamp_session::is_writable() const
 {
-    uint64_t request_id = ++m_request_id;
-
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::PUBLISH));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
+    return m_writable;
+}
 
+inline boost::future<void> wamp_session::wait_until_writable()
+{
     auto result = std::make_shared<boost::promise<void>>();
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 
-    m_io_service.dispatch([=]() {
+    boost::asio::dispatch(m_strand, [=]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
-        try {
-            send_message(std::move(*message));
+        if (m_writable) {
             result->set_value();
-        } catch (const std::exception& e) {
-            result->set_exception(boost::copy_exception(e));
+        } else {
+            m_writable_waiters.push_back(result);
         }
     });
 
     return result->get_future();
 }
 
-template <typename List>
-inline boost::future<void> wamp_session::publish(const std::string& topic, const List& arguments,const wamp_publish_options& options)
+inline boost::future<wamp_publication> wamp_session::publish(const std::string& topic,const wamp_publish_options& options)
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(5);
-    message->set_field(0, static_cast<int>(message_type::PUBLISH));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
-    message->set_field(4, arguments);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic);
 
-    auto result = std::make_shared<boost::promise<void>>();
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    auto published = std::make_shared<wamp_completion<wamp_publication>>();
+    auto result = published->get_future();
+    submit_publish(request_id, wamp_message(std::move(buffer)), options.acknowledge(), published);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    return result;
+}
 
-        try {
-            send_message(std::move(*message));
-            result->set_value();
-        } catch (const std::exception& e) {
-            result->set_exception(boost::copy_exception(e));
-        }
-    });
+template <typename List>
+inline boost::future<wamp_publication> wamp_session::publish(const std::string& topic, const List& arguments,const wamp_publish_options& options)
+{
+    uint64_t request_id = ++m_request_id;
 
-    return result->get_future();
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments);
+
+    auto published = std::make_shared<wamp_completion<wamp_publication>>();
+    auto result = published->get_future();
+    submit_publish(request_id, wamp_message(std::move(buffer)), options.acknowledge(), published);
+
+    return result;
 }
 
 template <typename List, typename Map>
-inline boost::future<void> wamp_session::publish(
+inline boost::future<wamp_publication> wamp_session::publish(
         const std::string& topic, const List& arguments, const Map& kw_arguments,const wamp_publish_options& options)
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(6);
-    message->set_field(0, static_cast<int>(message_type::PUBLISH));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
-    message->set_field(4, arguments);
-    message->set_field(5, kw_arguments);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments, kw_arguments);
 
-    auto result = std::make_shared<boost::promise<void>>();
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    auto published = std::make_shared<wamp_completion<wamp_publication>>();
+    auto result = published->get_future();
+    submit_publish(request_id, wamp_message(std::move(buffer)), options.acknowledge(), published);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    return result;
+}
 
-        try {
-            send_message(std::move(*message));
-            result->set_value();
-        } catch (const std::exception& e) {
-            result->set_exception(boost::copy_exception(e));
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_publication))
+wamp_session::async_publish(
+        const std::string& topic,
+        const wamp_publish_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+    bool acknowledge = options.acknowledge();
+
+    auto start = [this, request_id, message, acknowledge](
+            const wamp_completion_handler<wamp_publication>& handler) {
+        submit_publish(request_id, std::move(*message), acknowledge,
+                std::make_shared<wamp_completion<wamp_publication>>(handler));
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_publication)>(
+            initiation<wamp_publication>{this->shared_from_this()}, token, start);
+}
+
+template <typename List, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_publication))
+wamp_session::async_publish(
+        const std::string& topic,
+        const List& arguments,
+        const wamp_publish_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+    bool acknowledge = options.acknowledge();
+
+    auto start = [this, request_id, message, acknowledge](
+            const wamp_completion_handler<wamp_publication>& handler) {
+        submit_publish(request_id, std::move(*message), acknowledge,
+                std::make_shared<wamp_completion<wamp_publication>>(handler));
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_publication)>(
+            initiation<wamp_publication>{this->shared_from_this()}, token, start);
+}
+
+template <typename List, typename Map, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_publication))
+wamp_session::async_publish(
+        const std::string& topic,
+        const List& arguments,
+        const Map& kw_arguments,
+        const wamp_publish_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments, kw_arguments);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+    bool acknowledge = options.acknowledge();
+
+    auto start = [this, request_id, message, acknowledge](
+            const wamp_completion_handler<wamp_publication>& handler) {
+        submit_publish(request_id, std::move(*message), acknowledge,
+                std::make_shared<wamp_completion<wamp_publication>>(handler));
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_publication)>(
+            initiation<wamp_publication>{this->shared_from_this()}, token, start);
+}
+
+inline void wamp_session::publish_nowait(const std::string& topic, const wamp_publish_options& options)
+{
+    if (options.acknowledge()) {
+        throw std::invalid_argument("publish_nowait cannot be acknowledged");
+    }
+
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic);
+
+    wamp_submission submission;
+    submission.m_message = wamp_message(std::move(buffer));
+    submission.m_request_id = request_id;
+    submit(std::move(submission));
+}
+
+template <typename List>
+inline void wamp_session::publish_nowait(
+        const std::string& topic, const List& arguments, const wamp_publish_options& options)
+{
+    if (options.acknowledge()) {
+        throw std::invalid_argument("publish_nowait cannot be acknowledged");
+    }
+
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments);
+
+    wamp_submission submission;
+    submission.m_message = wamp_message(std::move(buffer));
+    submission.m_request_id = request_id;
+    submit(std::move(submission));
+}
+
+template <typename List, typename Map>
+inline void wamp_session::publish_nowait(
+        const std::string& topic, const List& arguments, const Map& kw_arguments, const wamp_publish_options& options)
+{
+    if (options.acknowledge()) {
+        throw std::invalid_argument("publish_nowait cannot be acknowledged");
+    }
+
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options, topic, arguments, kw_arguments);
+
+    wamp_submission submission;
+    submission.m_message = wamp_message(std::move(buffer));
+    submission.m_request_id = request_id;
+    submit(std::move(submission));
+}
+
+template <typename Range>
+inline boost::future<void> wamp_session::publish_batch(const Range& events)
+{
+    wamp_submission submission;
+    submission.m_batch.reserve(std::distance(std::begin(events), std::end(events)));
+
+    for (const auto& event : events) {
+        const wamp_publish_options& options = std::get<3>(event);
+        if (options.acknowledge()) {
+            throw std::invalid_argument("publish_batch cannot be acknowledged");
         }
-    });
 
-    return result->get_future();
+        uint64_t request_id = ++m_request_id;
+
+        auto buffer = acquire_buffer(m_buffer_pool);
+        serialize_message(*buffer, static_cast<int>(message_type::PUBLISH), request_id, options,
+                std::get<0>(event), std::get<1>(event), std::get<2>(event));
+
+        submission.m_batch.push_back(wamp_message(std::move(buffer)));
+    }
+
+    submission.m_batch_sent = std::make_shared<boost::promise<void>>();
+
+    auto result = submission.m_batch_sent->get_future();
+    submit(std::move(submission));
+
+    return result;
+}
+
+inline void wamp_session::set_error_handler(const wamp_error_handler& handler)
+{
+    m_error_handler = handler;
 }
 
 inline boost::future<wamp_subscription> wamp_session::subscribe(
@@ -331,30 +543,41 @@ inline boost::future<wamp_subscription> wamp_session::subscribe(
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::SUBSCRIBE));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, topic);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::SUBSCRIBE), request_id, options, topic);
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto subscribe_request = std::make_shared<wamp_subscribe_request>(handler);
+    auto subscribe_request = std::make_shared<wamp_subscribe_request>(
+            handler, topic, options.is_match_set() ? options.match() : "exact");
+    auto result = subscribe_request->response().get_future();
+    submit_subscribe(request_id, wamp_message(std::move(buffer)), subscribe_request);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    return result;
+}
 
-        try {
-            send_message(std::move(*message));
-            m_subscribe_requests.emplace(request_id, subscribe_request);
-        } catch (const std::exception& e) {
-            subscribe_request->response().set_exception(boost::copy_exception(e));
-        }
-    });
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_subscription))
+wamp_session::async_subscribe(
+        const std::string& topic,
+        const wamp_event_handler& handler,
+        const wamp_subscribe_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::SUBSCRIBE), request_id, options, topic);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+    std::string match = options.is_match_set() ? options.match() : "exact";
+
+    auto start = [this, request_id, message, handler, topic, match](
+            const wamp_completion_handler<wamp_subscription>& completion_handler) {
+        auto subscribe_request = std::make_shared<wamp_subscribe_request>(handler, topic, match);
+        subscribe_request->set_completion_handler(completion_handler);
+        submit_subscribe(request_id, std::move(*message), subscribe_request);
+    };
 
-    return subscribe_request->response().get_future();
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_subscription)>(
+            initiation<wamp_subscription>{this->shared_from_this()}, token, start);
 }
 
 inline boost::future<void> wamp_session::unsubscribe(const wamp_subscription& subscription)
@@ -369,17 +592,37 @@ inline boost::future<void> wamp_session::unsubscribe(const wamp_subscription& su
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
     auto unsubscribe_request = std::make_shared<wamp_unsubscribe_request>(subscription);
 
-    m_io_service.dispatch([=]() {
+    // Posted rather than dispatched so that an event handler unsubscribing
+    // itself never removes handlers while an event is being delivered.
+    boost::asio::post(m_strand, [=]() {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
+        // Anything submitted before unsubscribing reaches the router first.
+        drain_submissions(std::numeric_limits<std::size_t>::max());
+
         try {
+            if (subscription.handler_id() != 0) {
+                if (!m_subscription_handlers.remove(subscription.id(), subscription.handler_id())) {
+                    throw std::runtime_error("wamp.error.no_such_subscription");
+                }
+
+                // Other local handlers still share the router subscription.
+                if (m_subscription_handlers.find(subscription.id())) {
+                    unsubscribe_request->set_response();
+                    return;
+                }
+            } else {
+                m_subscription_handlers.remove(subscription.id());
+            }
+
+            release_topic_subscription(subscription.id());
             send_message(std::move(*message));
-            m_unsubscribe_requests.emplace(request_id, unsubscribe_request);
-        } catch (const std::exception& e) {
-            unsubscribe_request->response().set_exception(boost::copy_exception(e));
+            m_unsubscribe_requests.insert(request_id, unsubscribe_request);
+        } catch (const std::exception&) {
+            unsubscribe_request->response().set_exception(detail::to_boost_exception(std::current_exception()));
         }
     });
 
@@ -392,30 +635,15 @@ inline boost::future<wamp_call_result> wamp_session::call(
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(4);
-    message->set_field(0, static_cast<int>(message_type::CALL));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, procedure);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::CALL), request_id, options, procedure);
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
     auto call = std::make_shared<wamp_call>();
+    auto result = call->result().get_future();
+    submit_call(request_id, wamp_message(std::move(buffer)), options.timeout(),
+            options.progress_handler(), options.cancellation_token(), call);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
-
-        try {
-            send_message(std::move(*message));
-            m_calls.emplace(request_id, call);
-        } catch (const std::exception& e) {
-            call->result().set_exception(boost::copy_exception(e));
-        }
-    });
-
-    return call->result().get_future();
+    return result;
 }
 
 template<typename List>
@@ -426,31 +654,15 @@ inline boost::future<wamp_call_result> wamp_session::call(
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(5);
-    message->set_field(0, static_cast<int>(message_type::CALL));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, procedure);
-    message->set_field(4, arguments);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::CALL), request_id, options, procedure, arguments);
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
     auto call = std::make_shared<wamp_call>();
+    auto result = call->result().get_future();
+    submit_call(request_id, wamp_message(std::move(buffer)), options.timeout(),
+            options.progress_handler(), options.cancellation_token(), call);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
-
-        try {
-            send_message(std::move(*message));
-            m_calls.emplace(request_id, call);
-        } catch (const std::exception& e) {
-            call->result().set_exception(boost::copy_exception(e));
-        }
-    });
-
-    return call->result().get_future();
+    return result;
 }
 
 template<typename List, typename Map>
@@ -462,32 +674,114 @@ inline boost::future<wamp_call_result> wamp_session::call(
 {
     uint64_t request_id = ++m_request_id;
 
-    auto message = std::make_shared<wamp_message>(6);
-    message->set_field(0, static_cast<int>(message_type::CALL));
-    message->set_field(1, request_id);
-    message->set_field(2, options);
-    message->set_field(3, procedure);
-    message->set_field(4, arguments);
-    message->set_field(5, kw_arguments);
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::CALL), request_id, options, procedure, arguments, kw_arguments);
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
     auto call = std::make_shared<wamp_call>();
+    auto result = call->result().get_future();
+    submit_call(request_id, wamp_message(std::move(buffer)), options.timeout(),
+            options.progress_handler(), options.cancellation_token(), call);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    return result;
+}
 
-        try {
-            send_message(std::move(*message));
-            m_calls.emplace(request_id, call);
-        } catch (const std::exception& e) {
-            call->result().set_exception(boost::copy_exception(e));
-        }
-    });
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_call_result))
+wamp_session::async_call(
+        const std::string& procedure,
+        const wamp_call_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::CALL), request_id, options, procedure);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+
+    // The options may be gone by the time a deferred operation is started.
+    std::chrono::milliseconds timeout = options.timeout();
+    wamp_progress_handler progress_handler = options.progress_handler();
+    boost::optional<wamp_cancellation_token> cancellation_token;
+    if (options.cancellation_token()) {
+        cancellation_token = *options.cancellation_token();
+    }
+    auto start = [this, request_id, message, timeout, progress_handler, cancellation_token](
+            const wamp_completion_handler<wamp_call_result>& handler) {
+        auto call = std::make_shared<wamp_call>();
+        call->set_completion_handler(handler);
+        submit_call(request_id, std::move(*message), timeout,
+                progress_handler, cancellation_token.get_ptr(), call);
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_call_result)>(
+            initiation<wamp_call_result>{this->shared_from_this()}, token, start);
+}
+
+template <typename List, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_call_result))
+wamp_session::async_call(
+        const std::string& procedure,
+        const List& arguments,
+        const wamp_call_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::CALL), request_id, options, procedure, arguments);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
+
+    // The options may be gone by the time a deferred operation is started.
+    std::chrono::milliseconds timeout = options.timeout();
+    wamp_progress_handler progress_handler = options.progress_handler();
+    boost::optional<wamp_cancellation_token> cancellation_token;
+    if (options.cancellation_token()) {
+        cancellation_token = *options.cancellation_token();
+    }
+    auto start = [this, request_id, message, timeout, progress_handler, cancellation_token](
+            const wamp_completion_handler<wamp_call_result>& handler) {
+        auto call = std::make_shared<wamp_call>();
+        call->set_completion_handler(handler);
+        submit_call(request_id, std::move(*message), timeout,
+                progress_handler, cancellation_token.get_ptr(), call);
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_call_result)>(
+            initiation<wamp_call_result>{this->shared_from_this()}, token, start);
+}
+
+template <typename List, typename Map, typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_call_result))
+wamp_session::async_call(
+        const std::string& procedure,
+        const List& arguments,
+        const Map& kw_arguments,
+        const wamp_call_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto buffer = acquire_buffer(m_buffer_pool);
+    serialize_message(*buffer, static_cast<int>(message_type::CALL), request_id, options, procedure, arguments, kw_arguments);
+    auto message = std::make_shared<wamp_message>(std::move(buffer));
 
-    return call->result().get_future();
+    // The options may be gone by the time a deferred operation is started.
+    std::chrono::milliseconds timeout = options.timeout();
+    wamp_progress_handler progress_handler = options.progress_handler();
+    boost::optional<wamp_cancellation_token> cancellation_token;
+    if (options.cancellation_token()) {
+        cancellation_token = *options.cancellation_token();
+    }
+    auto start = [this, request_id, message, timeout, progress_handler, cancellation_token](
+            const wamp_completion_handler<wamp_call_result>& handler) {
+        auto call = std::make_shared<wamp_call>();
+        call->set_completion_handler(handler);
+        submit_call(request_id, std::move(*message), timeout,
+                progress_handler, cancellation_token.get_ptr(), call);
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_call_result)>(
+            initiation<wamp_call_result>{this->shared_from_this()}, token, start);
 }
 
 inline boost::future<wamp_registration> wamp_session::provide(
@@ -500,27 +794,46 @@ inline boost::future<wamp_registration> wamp_session::provide(
     auto message = std::make_shared<wamp_message>(4);
     message->set_field(0, static_cast<int>(message_type::REGISTER));
     message->set_field(1, request_id);
-    message->set_field(2, options);
+    message->set_field(2, options.options());
     message->set_field(3, name);
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto register_request = std::make_shared<wamp_register_request>(procedure);
+    auto register_request = std::make_shared<wamp_register_request>(
+            procedure, options.max_concurrency(), options.max_queue_depth());
+    auto result = register_request->response().get_future();
+    submit_register(request_id, message, register_request);
 
-    m_io_service.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    return result;
+}
 
-        try {
-            send_message(std::move(*message));
-            m_register_requests.emplace(request_id, register_request);
-        } catch (const std::exception& e) {
-            register_request->response().set_exception(boost::copy_exception(e));
-        }
-    });
+template <typename CompletionToken>
+inline BOOST_ASIO_INITFN_RESULT_TYPE(CompletionToken, void(std::exception_ptr, wamp_registration))
+wamp_session::async_provide(
+        const std::string& name,
+        const wamp_procedure& procedure,
+        const provide_options& options,
+        CompletionToken&& token)
+{
+    uint64_t request_id = ++m_request_id;
+
+    auto message = std::make_shared<wamp_message>(4);
+    message->set_field(0, static_cast<int>(message_type::REGISTER));
+    message->set_field(1, request_id);
+    message->set_field(2, options.options());
+    message->set_field(3, name);
 
-    return register_request->response().get_future();
+    // The options may be gone by the time a deferred operation is started.
+    std::size_t max_concurrency = options.max_concurrency();
+    std::size_t max_queue_depth = options.max_queue_depth();
+    auto start = [this, request_id, message, procedure, max_concurrency, max_queue_depth](
+            const wamp_completion_handler<wamp_registration>& handler) {
+        auto register_request = std::make_shared<wamp_register_request>(
+                procedure, max_concurrency, max_queue_depth);
+        register_request->set_completion_handler(handler);
+        submit_register(request_id, message, register_request);
+    };
+
+    return boost::asio::async_initiate<CompletionToken, void(std::exception_ptr, wamp_registration)>(
+            initiation<wamp_registration>{this->shared_from_this()}, token, start);
 }
 
 inline boost::future<void> wamp_session::unprovide(const wamp_registration& registration)
@@ -535,18 +848,20 @@ inline boost::future<void> wamp_session::unprovide(const wamp_registration& regi
 	auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
 	auto unregister_request = std::make_shared<wamp_unregister_request>(registration);
 
-	m_io_service.dispatch([=]() {
+	boost::asio::dispatch(m_strand, [=]() {
 		auto shared_self = weak_self.lock();
 		if (!shared_self) {
 			return;
 		}
 
+		drain_submissions(std::numeric_limits<std::size_t>::max());
+
 		try {
 			send_message(std::move(*message));
-			m_unregister_requests.emplace(request_id, unregister_request);
+			m_unregister_requests.insert(request_id, unregister_request);
 		}
-		catch (const std::exception& e) {
-			unregister_request->response().set_exception(boost::copy_exception(e));
+		catch (const std::exception&) {
+			unregister_request->response().set_exception(detail::to_boost_exception(std::current_exception()));
 		}
 	});
 
@@ -577,29 +892,89 @@ inline void wamp_session::on_attach(const std::shared_ptr<wamp_transport>& trans
     assert(!m_running);
 
     m_transport = transport;
-}
+    m_strand = transport->strand();
 
-inline void wamp_session::on_detach(bool was_clean, const std::string& reason)
-{
-    // FIXME: We should be deferring this operation to the io service. This
-    //        will almost certainly require us to return a future here to
-    //        all the caller to sync up with the actual detaching of the
-    //        transport.
+    // Outbound messages are serialized on the caller's thread, so the pool
+    // is kept for as long as the session lives rather than being dropped on
+    // detach. Buffers released into it after that are simply reused later.
+    m_buffer_pool = transport->buffer_pool();
 
-    if (!m_transport) {
-        throw protocol_error("Transport already detached from session");
-    }
+    // Any handlers the application installed on the transport keep being
+    // invoked after the session's own.
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    auto paused = transport->get_pause_handler();
+    m_chained_pause_handler = paused;
+    transport->set_pause_handler([weak_self, paused]() {
+        auto shared_self = weak_self.lock();
+        if (shared_self) {
+            shared_self->on_transport_paused();
+        }
+        if (paused) {
+            paused();
+        }
+    });
+    auto resumed = transport->get_resume_handler();
+    m_chained_resume_handler = resumed;
+    transport->set_resume_handler([weak_self, resumed]() {
+        auto shared_self = weak_self.lock();
+        if (shared_self) {
+            shared_self->on_transport_resumed();
+        }
+        if (resumed) {
+            resumed();
+        }
+    });
+}
 
-    // FIXME: Figure out what to do if we are detaching a transport
-    //        from a session that is still running. Ideally we would
-    //        not detach the transport until m_session_stop is satisfied.
-    //        Perhaps we could use the same promise/future discussed above.
-    //        One side effect here will be if the transport is re-used for
-    //        another session as it may still receive messages for the old
-    //        session.
-    assert(!m_running);
+inline void wamp_session::on_detach(bool was_clean, const std::string& reason)
+{
+    // The transport is torn down on the strand, since everything that
+    // sends or receives on it runs there too. Transports detach from their
+    // strand already, in which case this runs straight away.
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    boost::asio::dispatch(m_strand, [=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        if (!m_transport) {
+            report_error(protocol_error("Transport already detached from session"));
+            return;
+        }
 
-    m_transport.reset();
+        // FIXME: Figure out what to do if we are detaching a transport
+        //        from a session that is still running. Ideally we would
+        //        not detach the transport until m_session_stop is satisfied.
+        //        Perhaps we could use the same promise/future discussed above.
+        //        One side effect here will be if the transport is re-used for
+        //        another session as it may still receive messages for the old
+        //        session.
+        assert(!m_running || !was_clean);
+
+        // A transport whose connection failed detaches from a running
+        // session, which stops it so that it can be started again once
+        // another transport is attached.
+        m_running = false;
+
+        // Hand the transport back with the handlers it had before attaching.
+        m_transport->set_pause_handler(std::move(m_chained_pause_handler));
+        m_transport->set_resume_handler(std::move(m_chained_resume_handler));
+        m_transport.reset();
+
+        // Nobody is going to drain the queue now, so don't leave anyone waiting.
+        m_writable = true;
+        for (auto& waiter : m_writable_waiters) {
+            waiter->set_exception(boost::copy_exception(no_transport_error()));
+        }
+        m_writable_waiters.clear();
+
+        // Invocations can no longer be interrupted once the transport is gone.
+        m_invocations.clear();
+
+        fail_pending_requests();
+    });
 }
 
 inline void wamp_session::on_message(wamp_message&& message)
@@ -645,7 +1020,7 @@ inline void wamp_session::on_message(wamp_message&& message)
         case message_type::PUBLISH:
             throw protocol_error("received PUBLISH message unexpected for WAMP client roles");
         case message_type::PUBLISHED:
-            // FIXME
+            process_published(std::move(message));
             break;
         case message_type::SUBSCRIBE:
             throw protocol_error("received SUBSCRIBE message unexpected for WAMP client roles");
@@ -681,7 +1056,8 @@ inline void wamp_session::on_message(wamp_message&& message)
             process_invocation(std::move(message));
             break;
         case message_type::INTERRUPT:
-            throw protocol_error("received INTERRUPT message - not implemented");
+            process_interrupt(std::move(message));
+            break;
         case message_type::YIELD:
             throw protocol_error("received YIELD message unexpected for WAMP client roles");
     }
@@ -773,7 +1149,7 @@ inline void wamp_session::process_challenge(wamp_message&& message)
             message->set_field(2, std::unordered_map<int, int>() /* No Extra/Dict */);
 
             auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-            m_io_service.dispatch([=]() {
+            boost::asio::dispatch(m_strand, [=]() {
                 auto shared_self = weak_self.lock();
                 if (!shared_self) {
                     return;
@@ -804,7 +1180,12 @@ inline void wamp_session::process_welcome(wamp_message&& message)
 {
     m_session_id = message.field<uint64_t>(1);
     message.field(2).convert(m_welcome_details);
-    m_session_join.set_value(m_session_id);
+    m_router_call_canceling = has_feature(message.field(2), "dealer", "call_canceling");
+
+    if (m_session_join) {
+        auto joined = std::move(m_session_join);
+        joined->set_value(uint64_t(m_session_id));
+    }
 }
 
 inline void wamp_session::process_abort(wamp_message&& message)
@@ -826,7 +1207,10 @@ inline void wamp_session::process_abort(wamp_message&& message)
     }
 
     std::string uri = message.field<std::string>(2);
-    m_session_join.set_exception(boost::copy_exception(abort_error(uri)));
+    if (m_session_join) {
+        auto joined = std::move(m_session_join);
+        joined->set_exception(abort_error(uri));
+    }
 }
 
 inline void wamp_session::process_goodbye(wamp_message&& message)
@@ -847,8 +1231,17 @@ inline void wamp_session::process_goodbye(wamp_message&& message)
         // is the peer reply.
     }
 
+    // The router won't answer subscribe requests that are still pending.
+    reset_subscriptions();
+    fail_requests(m_subscribe_requests, [](const std::shared_ptr<wamp_subscribe_request>& subscribe_request) {
+        subscribe_request->set_exception(no_session_error());
+    });
+
     std::string reason = message.field<std::string>(2);
-    m_session_leave.set_value(reason);
+    if (m_session_leave) {
+        auto left = std::move(m_session_leave);
+        left->set_value(std::move(reason));
+    }
 }
 
 inline void wamp_session::process_error(wamp_message&& message)
@@ -929,24 +1322,23 @@ inline void wamp_session::process_error(wamp_message&& message)
                 //
                 // process CALL ERROR
                 //
-                auto call_itr = m_calls.find(request_id);
-
-                if (call_itr != m_calls.end()) {
+                std::shared_ptr<wamp_call> call;
+                if (m_calls.extract(request_id, call)) {
+                    m_call_timeouts.cancel(call->deadline());
                     // FIXME: Forward all error info.
-                    call_itr->second->result().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_calls.erase(call_itr);
-                } else {
-                    throw protocol_error("bogus ERROR message for non-pending CALL request ID: " + error);
+                    call->set_exception(std::runtime_error(error));
+                } else if (m_debug_enabled) {
+                    // The call may have already timed out locally.
+                    std::cerr << "ERROR for non-pending CALL request ID " << request_id << ": " << error << std::endl;
                 }
             }
             break;
         case message_type::REGISTER:
             {
-                auto reg_itr = m_register_requests.find(request_id);
-                if (reg_itr != m_register_requests.end())
+                std::shared_ptr<wamp_register_request> register_request;
+                if (m_register_requests.extract(request_id, register_request))
                 {
-                    reg_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_register_requests.erase(reg_itr);
+                    register_request->set_exception(std::runtime_error(error));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending REGISTER request ID: " + error);
                 }
@@ -954,11 +1346,10 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::UNREGISTER:
             {
-                auto unreg_itr = m_unregister_requests.find(request_id);
-                if (unreg_itr != m_unregister_requests.end())
+                std::shared_ptr<wamp_unregister_request> unregister_request;
+                if (m_unregister_requests.extract(request_id, unregister_request))
                 {
-                   unreg_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                   m_unregister_requests.erase(unreg_itr);
+                   unregister_request->response().set_exception(boost::copy_exception(std::runtime_error(error)));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending UNREGISTER request ID: " + error);
                 }
@@ -966,19 +1357,21 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::PUBLISH:
             {
-                //TODO: there's currently no way to get to the future returned by the publish function
-                // but there needs to be something more sensibly then just propagating the error to the
-                // function running the io_service
-                throw protocol_error("Received ERROR for a PUBLISH request: " + error);
+                // Only acknowledged publications are answered with an ERROR.
+                std::shared_ptr<wamp_completion<wamp_publication>> published;
+                if (m_publish_requests.extract(request_id, published)) {
+                    published->set_exception(std::runtime_error(error));
+                } else {
+                    throw protocol_error("bogus ERROR message for non-pending PUBLISH request ID: " + error);
+                }
             }
             break;
         case message_type::SUBSCRIBE:
             {
-                auto sub_itr = m_subscribe_requests.find(request_id);
-                if (sub_itr != m_subscribe_requests.end())
+                std::shared_ptr<wamp_subscribe_request> subscribe_request;
+                if (m_subscribe_requests.extract(request_id, subscribe_request))
                 {
-                    sub_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_subscribe_requests.erase(sub_itr);
+                    fail_topic_subscription(subscribe_request, std::runtime_error(error));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending SUBSCRIBE request ID: " + error);
                 }
@@ -986,11 +1379,10 @@ inline void wamp_session::process_error(wamp_message&& message)
             break;
         case message_type::UNSUBSCRIBE:
             {
-                auto unsub_itr = m_unsubscribe_requests.find(request_id);
-                if (unsub_itr != m_unsubscribe_requests.end())
+                std::shared_ptr<wamp_unsubscribe_request> unsubscribe_request;
+                if (m_unsubscribe_requests.extract(request_id, unsubscribe_request))
                 {
-                    unsub_itr->second->response().set_exception(boost::copy_exception(std::runtime_error(error)));
-                    m_unsubscribe_requests.erase(unsub_itr);
+                    unsubscribe_request->response().set_exception(boost::copy_exception(std::runtime_error(error)));
                 } else {
                     throw protocol_error("bogus ERROR message for non-pending UNSUBSCRIBE request ID: " + error);
                 }
@@ -1029,6 +1421,18 @@ inline void wamp_session::process_invocation(wamp_message&& message)
             throw protocol_error("INVOCATION.Details must be a map");
         }
 
+        wamp_registered_procedure& registered = procedure_itr->second;
+        const bool admitted = registered.m_max_concurrency == 0
+                || registered.m_statistics.running() < registered.m_max_concurrency;
+
+        // Shed the load right away rather than letting the caller wait on a
+        // queue that isn't going to drain in time.
+        if (!admitted && registered.m_statistics.queued() >= registered.m_max_queue_depth) {
+            registered.m_statistics.record_rejected();
+            send_invocation_error(request_id, "wamp.error.busy");
+            return;
+        }
+
         wamp_invocation invocation = std::make_shared<wamp_invocation_impl>();
         invocation->set_request_id(request_id);
         invocation->set_details(message.field(3));
@@ -1047,55 +1451,236 @@ inline void wamp_session::process_invocation(wamp_message&& message)
         }
 
         invocation->set_zone(std::move(message.zone()));
+        invocation->set_buffer_pool(m_buffer_pool);
+        invocation->set_send_result_fn(make_send_result_fn(request_id));
+
+        // Tracked whether or not it runs yet, so that an INTERRUPT reaches
+        // it while it waits.
+        wamp_pending_invocation pending;
+        pending.m_invocation = invocation;
+        pending.m_registration_id = registration_id;
+        pending.m_queued = !admitted;
+        m_invocations.insert(request_id, pending);
+
+        if (!admitted) {
+            registered.m_queue.push_back(invocation);
+            registered.m_statistics.record_queued();
+            return;
+        }
 
-        auto weak_this = std::weak_ptr<wamp_session>(this->shared_from_this());
+        admit_invocation(registration_id, registered, invocation);
 
-        auto send_result_fn = [weak_this] (const std::shared_ptr<wamp_message>& message) {
-            // Make sure the session still exists, since the invocation could run
-            // on a different thread.
+        // FIXME: implement Autobahn-specific exception with error URI
+        detail::invoke_procedure(registered.m_procedure, invocation);
+    } else {
+        throw protocol_error("bogus INVOCATION message for non-registered registration ID");
+    }
+}
+
+inline wamp_invocation_impl::send_result_fn wamp_session::make_send_result_fn(uint64_t request_id)
+{
+    auto weak_this = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    return [weak_this, request_id] (const std::shared_ptr<wamp_message>& message, bool final) {
+        // Make sure the session still exists, since the invocation could run
+        // on a different thread.
+        auto shared_this = weak_this.lock();
+        if (!shared_this) {
+            return; // FIXME: or throw exception?
+        }
+
+        // Send to the session's strand, and make sure the session still exists (again).
+        boost::asio::dispatch(shared_this->m_strand, [weak_this, message, request_id, final] {
             auto shared_this = weak_this.lock();
             if (!shared_this) {
                 return; // FIXME: or throw exception?
             }
 
-            // Send to the io_service thread, and make sure the session still exists (again).
-            shared_this->m_io_service.dispatch([weak_this, message] {
-                auto shared_this = weak_this.lock();
-                if (!shared_this) {
-                    return; // FIXME: or throw exception?
-                }
-                shared_this->send_message(std::move(*message));
-            });
-        };
+            // The caller may already have been answered, for instance when an
+            // earlier result couldn't be sent.
+            if (!shared_this->m_invocations.find(request_id)) {
+                return;
+            }
+            if (final) {
+                shared_this->complete_invocation(request_id);
+            }
 
-        invocation->set_send_result_fn(std::move(send_result_fn));
+            shared_this->drain_submissions(std::numeric_limits<std::size_t>::max());
 
-        try {
-            if (m_debug_enabled) {
-                std::cerr << "Invoking procedure registered under " << registration_id << std::endl;
+            try {
+                shared_this->send_message(std::move(*message));
+            } catch (const protocol_error&) {
+                // The transport refused the result, most likely because it is
+                // too large, so answer the caller with an error instead.
+                if (!final) {
+                    shared_this->complete_invocation(request_id);
+                }
+                shared_this->send_invocation_error(request_id, "wamp.error.payload_size_exceeded");
+            } catch (const std::exception& e) {
+                shared_this->report_error(e);
             }
-            procedure_itr->second(invocation);
+        });
+    };
+}
+
+inline void wamp_session::send_invocation_error(uint64_t request_id, const std::string& error_uri)
+{
+    // [ERROR, INVOCATION, INVOCATION.Request|id, Details|dict, Error|uri]
+    wamp_message message(5);
+    message.set_field(0, static_cast<int>(message_type::ERROR));
+    message.set_field(1, static_cast<int>(message_type::INVOCATION));
+    message.set_field(2, request_id);
+    message.set_field(3, std::map<int, int>() /* No details */);
+    message.set_field(4, error_uri);
+
+    try {
+        send_message(std::move(message));
+    } catch (const std::exception& e) {
+        report_error(e);
+    }
+}
+
+inline void wamp_session::admit_invocation(
+        uint64_t registration_id, wamp_registered_procedure& registered, const wamp_invocation& invocation)
+{
+    wamp_pending_invocation* pending = m_invocations.find(invocation->request_id());
+    if (pending) {
+        pending->m_queued = false;
+    }
+    registered.m_statistics.record_started();
+
+    if (m_debug_enabled) {
+        std::cerr << "Invoking procedure registered under " << registration_id << std::endl;
+    }
+}
+
+inline void wamp_session::complete_invocation(uint64_t request_id)
+{
+    wamp_pending_invocation pending;
+    if (!m_invocations.extract(request_id, pending)) {
+        return;
+    }
+
+    // Only a running invocation frees up a slot.
+    if (!pending.m_queued) {
+        finish_invocation(pending.m_registration_id);
+    }
+}
+
+inline void wamp_session::finish_invocation(uint64_t registration_id)
+{
+    auto procedure_itr = m_procedures.find(registration_id);
+    if (procedure_itr == m_procedures.end()) {
+        return;
+    }
+
+    wamp_registered_procedure& registered = procedure_itr->second;
+    registered.m_statistics.record_finished();
+
+    while (!registered.m_queue.empty()
+            && registered.m_statistics.running() < registered.m_max_concurrency) {
+        wamp_invocation invocation = std::move(registered.m_queue.front());
+        registered.m_queue.pop_front();
+
+        // Interrupted while it was waiting, and already answered.
+        if (!invocation->sendable()) {
+            continue;
         }
+        registered.m_statistics.record_dequeued();
+
+        // The slot is taken right away, but the procedure is called from a
+        // fresh handler so that procedures replying straight away don't
+        // recurse through the whole queue.
+        admit_invocation(registration_id, registered, invocation);
+        wamp_procedure procedure = registered.m_procedure;
+        boost::asio::post(m_strand, [procedure, invocation]() {
+            detail::invoke_procedure(procedure, invocation);
+        });
+    }
+}
 
-        // FIXME: implement Autobahn-specific exception with error URI
-        catch (const std::exception& e) {
-            // we can at least describe the error with e.what()
-            //
-            if (invocation->sendable()) {
-                std::map<std::string, std::string> error_kw_arguments;
-                error_kw_arguments["what"] = e.what();
-                invocation->error("wamp.error.runtime_error", EMPTY_ARGUMENTS, error_kw_arguments);
-            }
+inline wamp_invocation_statistics wamp_session::invocation_statistics(const wamp_registration& registration) const
+{
+    auto procedure_itr = m_procedures.find(registration.id());
+    if (procedure_itr == m_procedures.end()) {
+        return wamp_invocation_statistics();
+    }
+
+    return procedure_itr->second.m_statistics;
+}
+
+inline void wamp_session::process_interrupt(wamp_message&& message)
+{
+    // [INTERRUPT, INVOCATION.Request|id, Options|dict]
+
+    if (message.size() != 3) {
+        throw protocol_error("INTERRUPT - length must be 3");
+    }
+
+    if (!message.is_field_type(1, msgpack::type::POSITIVE_INTEGER)) {
+        throw protocol_error("INTERRUPT - INVOCATION.Request must be an integer");
+    }
+    uint64_t request_id = message.field<uint64_t>(1);
+
+    if (!message.is_field_type(2, msgpack::type::MAP)) {
+        throw protocol_error("INTERRUPT - Options must be a dictionary");
+    }
+
+    wamp_cancel_mode mode = wamp_cancel_mode::kill;
+    std::unordered_map<std::string, msgpack::object> options;
+    message.field(2).convert(options);
+    auto mode_itr = options.find("mode");
+    if (mode_itr != options.end()) {
+        mode = to_cancel_mode(mode_itr->second.as<std::string>());
+    }
+
+    wamp_pending_invocation* pending = m_invocations.find(request_id);
+    if (!pending) {
+        // The invocation may have replied while the INTERRUPT was in flight.
+        if (m_debug_enabled) {
+            std::cerr << "INTERRUPT - no running invocation " << request_id << std::endl;
         }
-        catch (...) {
-            // no information available on actual error
-            //
-            if (invocation->sendable()) {
-                invocation->error("wamp.error.runtime_error");
+        return;
+    }
+
+    auto invocation = pending->m_invocation.lock();
+    if (!invocation) {
+        // The invocation was dropped without ever replying.
+        m_invocations.erase(request_id);
+        return;
+    }
+
+    // An invocation still waiting for a slot never started, so it is
+    // answered right away rather than holding up the queue. Its entry is
+    // skipped once it reaches the front of the queue.
+    if (pending->m_queued) {
+        auto procedure_itr = m_procedures.find(pending->m_registration_id);
+        if (invocation->sendable()) {
+            invocation->error("wamp.error.canceled");
+        }
+
+        if (procedure_itr != m_procedures.end()) {
+            wamp_registered_procedure& registered = procedure_itr->second;
+            registered.m_statistics.record_dequeued();
+
+            // Don't let answered entries pile up behind a running invocation
+            // that is stuck.
+            std::deque<wamp_invocation>& queue = registered.m_queue;
+            if (queue.size() > 2 * registered.m_statistics.queued() + 1) {
+                queue.erase(std::remove_if(queue.begin(), queue.end(), [](const wamp_invocation& queued) {
+                    return !queued->sendable();
+                }), queue.end());
             }
         }
-    } else {
-        throw protocol_error("bogus INVOCATION message for non-registered registration ID");
+        return;
+    }
+
+    try {
+        invocation->cancellation_token().cancel(mode);
+    } catch (...) {
+        if (m_debug_enabled) {
+            std::cerr << "Warning: cancellation handler threw exception" << std::endl;
+        }
     }
 }
 
@@ -1114,30 +1699,80 @@ inline void wamp_session::process_call_result(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto call_itr = m_calls.find(request_id);
-    if (call_itr != m_calls.end()) {
-        if (!message.is_field_type(2, msgpack::type::MAP)) {
-            throw protocol_error("RESULT - Details must be a dictionary");
+    std::shared_ptr<wamp_call>* pending_call = m_calls.find(request_id);
+    if (!pending_call) {
+        if (m_debug_enabled) {
+            // The call may have already timed out locally.
+            std::cerr << "RESULT for non-pending CALL request ID " << request_id << std::endl;
+        }
+        return;
+    }
+
+    if (!message.is_field_type(2, msgpack::type::MAP)) {
+        throw protocol_error("RESULT - Details must be a dictionary");
+    }
+    const bool progress = value_for_key_or<bool>(message.field(2), "progress", false);
+
+    wamp_call_result result(std::move(message.zone()));
+    if (message.size() > 3) {
+        if (!message.is_field_type(3, msgpack::type::ARRAY)) {
+            throw protocol_error("RESULT - YIELD.Arguments must be a list");
         }
+        result.set_arguments(message.field(3));
 
-        wamp_call_result result(std::move(message.zone()));
-        if (message.size() > 3) {
-            if (!message.is_field_type(3, msgpack::type::ARRAY)) {
-                throw protocol_error("RESULT - YIELD.Arguments must be a list");
+        if (message.size() > 4) {
+            if (!message.is_field_type(4, msgpack::type::MAP)) {
+                throw protocol_error("RESULT - YIELD.ArgumentsKw must be a dictionary");
             }
-            result.set_arguments(message.field(3));
+            result.set_kw_arguments(message.field(4));
+        }
+    }
 
-            if (message.size() > 4) {
-                if (!message.is_field_type(4, msgpack::type::MAP)) {
-                    throw protocol_error("RESULT - YIELD.ArgumentsKw must be a dictionary");
-                }
-                result.set_kw_arguments(message.field(4));
+    if (progress) {
+        // The handler may cancel the call, so hold on to it while it runs.
+        std::shared_ptr<wamp_call> call = *pending_call;
+        if (!call->progress_handler()) {
+            return;
+        }
+
+        try {
+            call->progress_handler()(result);
+        } catch (...) {
+            if (m_debug_enabled) {
+                std::cerr << "Warning: progress handler threw exception" << std::endl;
             }
         }
-        call_itr->second->set_result(std::move(result));
-        m_calls.erase(call_itr);
+        return;
+    }
+
+    std::shared_ptr<wamp_call> call;
+    m_calls.extract(request_id, call);
+    m_call_timeouts.cancel(call->deadline());
+    call->set_result(std::move(result));
+}
+
+inline void wamp_session::process_published(wamp_message&& message)
+{
+    // [PUBLISHED, PUBLISH.Request|id, Publication|id]
+    if (message.size() != 3) {
+        throw protocol_error("PUBLISHED - length must be 3");
+    }
+
+    if (!message.is_field_type(1, msgpack::type::POSITIVE_INTEGER)) {
+        throw protocol_error("PUBLISHED - PUBLISH.Request must be an integer");
+    }
+    uint64_t request_id = message.field<uint64_t>(1);
+
+    if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
+        throw protocol_error("PUBLISHED - Publication must be an integer");
+    }
+    uint64_t publication_id = message.field<uint64_t>(2);
+
+    std::shared_ptr<wamp_completion<wamp_publication>> published;
+    if (m_publish_requests.extract(request_id, published)) {
+        published->set_value(wamp_publication(publication_id));
     } else {
-        throw protocol_error("bogus RESULT message for non-pending request ID");
+        throw protocol_error("PUBLISHED - no pending request ID");
     }
 }
 
@@ -1153,17 +1788,14 @@ inline void wamp_session::process_subscribed(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto subscribe_request_itr = m_subscribe_requests.find(request_id);
-    if (subscribe_request_itr != m_subscribe_requests.end()) {
+    std::shared_ptr<wamp_subscribe_request> subscribe_request;
+    if (m_subscribe_requests.extract(request_id, subscribe_request)) {
         if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
             throw protocol_error("SUBSCRIBED - SUBSCRIBED.Subscription must be an integer");
         }
 
         uint64_t subscription_id = message.field<uint64_t>(2);
-        m_subscription_handlers.insert(
-                std::make_pair(subscription_id, subscribe_request_itr->second->handler()));
-        subscribe_request_itr->second->set_response(wamp_subscription(subscription_id));
-        m_subscribe_requests.erase(request_id);
+        confirm_topic_subscription(request_id, subscribe_request, subscription_id);
     } else {
         throw protocol_error("SUBSCRIBED - no pending request ID");
     }
@@ -1181,12 +1813,10 @@ inline void wamp_session::process_unsubscribed(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto unsubscribe_request_itr = m_unsubscribe_requests.find(request_id);
-    if (unsubscribe_request_itr != m_unsubscribe_requests.end()) {
-        uint64_t subscription_id = unsubscribe_request_itr->second->subscription().id();
-        m_subscription_handlers.erase(subscription_id);
-        unsubscribe_request_itr->second->set_response();
-        m_unsubscribe_requests.erase(request_id);
+    std::shared_ptr<wamp_unsubscribe_request> unsubscribe_request;
+    if (m_unsubscribe_requests.extract(request_id, unsubscribe_request)) {
+        // The handlers were already removed when the UNSUBSCRIBE was sent.
+        unsubscribe_request->set_response();
     } else {
         throw protocol_error("UNSUBSCRIBED - no pending request ID");
     }
@@ -1207,16 +1837,15 @@ inline void wamp_session::process_event(wamp_message&& message)
     }
     uint64_t subscription_id = message.field<uint64_t>(1);
 
-    auto subscription_handlers_itr = m_subscription_handlers.lower_bound(subscription_id);
-    auto subscription_handlers_end = m_subscription_handlers.upper_bound(subscription_id);
-
-    if (subscription_handlers_itr != m_subscription_handlers.end() &&
-            subscription_handlers_itr != subscription_handlers_end) {
+    // Holding on to the handlers keeps them alive, unchanged, even if one
+    // of them leaves, detaches or subscribes from within the strand.
+    std::shared_ptr<const wamp_event_handlers> handlers = m_subscription_handlers.find(subscription_id);
+    if (handlers) {
 
         if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
             throw protocol_error("EVENT - PUBLISHED.Publication must be an id");
         }
-        //uint64_t publication_id = message[2].as<uint64_t>();
+        uint64_t publication_id = message.field<uint64_t>(2);
 
         if (!message.is_field_type(3, msgpack::type::MAP)) {
             throw protocol_error("EVENT - Details must be a dictionary");
@@ -1224,6 +1853,7 @@ inline void wamp_session::process_event(wamp_message&& message)
 
         wamp_event event = std::make_shared<wamp_event_impl>(std::move(message.zone()));
 
+        event->set_publication_id(publication_id);
         event->set_details(message.field(3));
 
         if (message.size() > 4) {
@@ -1243,9 +1873,8 @@ inline void wamp_session::process_event(wamp_message&& message)
         try {
             // now trigger the user supplied event handler ..
             //
-            while (subscription_handlers_itr != subscription_handlers_end) {
-                 (subscription_handlers_itr->second)(event);
-                 ++subscription_handlers_itr;
+            for (std::size_t index = 0; index < handlers->size(); ++index) {
+                (*handlers)[index](event);
             }
         } catch (...) {
             if (m_debug_enabled) {
@@ -1276,16 +1905,18 @@ inline void wamp_session::process_registered(wamp_message&& message)
     }
     uint64_t request_id = message.field<uint64_t>(1);
 
-    auto register_request_itr = m_register_requests.find(request_id);
-    if (register_request_itr != m_register_requests.end()) {
+    std::shared_ptr<wamp_register_request> register_request;
+    if (m_register_requests.extract(request_id, register_request)) {
         if (!message.is_field_type(2, msgpack::type::POSITIVE_INTEGER)) {
             throw protocol_error("REGISTERED - REGISTERED.Registration must be an integer");
         }
         uint64_t registration_id = message.field<uint64_t>(2);
 
-        m_procedures[registration_id] = register_request_itr->second->procedure();
-        register_request_itr->second->set_response(wamp_registration(registration_id));
-        m_register_requests.erase(register_request_itr);
+        wamp_registered_procedure& registered = m_procedures[registration_id];
+        registered.m_procedure = register_request->procedure();
+        registered.m_max_concurrency = register_request->max_concurrency();
+        registered.m_max_queue_depth = register_request->max_queue_depth();
+        register_request->set_response(wamp_registration(registration_id));
     } else {
         throw protocol_error("REGISTERED - no pending request ID");
     }
@@ -1303,18 +1934,42 @@ inline void wamp_session::process_unregistered(wamp_message&& message)
     }
 
     uint64_t request_id = message.field<uint64_t>(1);
-	auto unregister_request_itr = m_unregister_requests.find(request_id);
-    if (unregister_request_itr != m_unregister_requests.end()) {
-        uint64_t registration_id = unregister_request_itr->second->registration().id();
-        m_procedures.erase(registration_id);
-        unregister_request_itr->second->set_response();
-        m_unregister_requests.erase(request_id);
+    std::shared_ptr<wamp_unregister_request> unregister_request;
+    if (m_unregister_requests.extract(request_id, unregister_request)) {
+        uint64_t registration_id = unregister_request->registration().id();
+
+        // Invocations still waiting for a turn will never run now.
+        auto procedure_itr = m_procedures.find(registration_id);
+        if (procedure_itr != m_procedures.end()) {
+            std::deque<wamp_invocation> queue;
+            queue.swap(procedure_itr->second.m_queue);
+            m_procedures.erase(procedure_itr);
+
+            for (const auto& invocation : queue) {
+                if (invocation->sendable()) {
+                    invocation->error("wamp.error.canceled");
+                }
+            }
+        }
+        unregister_request->set_response();
     } else {
         throw protocol_error("UNREGISTERED - no pending request ID");
     }
 }
 
 inline void wamp_session::send_message(wamp_message&& message, bool session_established)
+{
+    check_sendable(session_established);
+    m_transport->send_message(std::move(message));
+}
+
+inline void wamp_session::send_messages(std::vector<wamp_message>&& messages)
+{
+    check_sendable(true);
+    m_transport->send_messages(std::move(messages));
+}
+
+inline void wamp_session::check_sendable(bool session_established)
 {
     if (!m_running) {
         throw protocol_error("session not running");
@@ -1331,8 +1986,517 @@ inline void wamp_session::send_message(wamp_message&& message, bool session_esta
     if (session_established && !m_session_id) {
         throw no_session_error();
     }
+}
 
-    m_transport->send_message(std::move(message));
+template <typename Result>
+template <typename Handler, typename Start>
+inline void wamp_session::initiation<Result>::operator()(Handler&& handler, const Start& start) const
+{
+    start(make_completion_handler<Result>(std::forward<Handler>(handler), m_session->m_io_service));
+}
+
+inline void wamp_session::submit_publish(uint64_t request_id, wamp_message&& message,
+        bool acknowledge, const std::shared_ptr<wamp_completion<wamp_publication>>& published)
+{
+    wamp_submission submission;
+    submission.m_message = std::move(message);
+    submission.m_request_id = request_id;
+    submission.m_published = published;
+    submission.m_acknowledge = acknowledge;
+
+    submit(std::move(submission));
+}
+
+inline void wamp_session::submit_call(uint64_t request_id, wamp_message&& message,
+        const std::chrono::milliseconds& timeout, const wamp_progress_handler& progress_handler,
+        const wamp_cancellation_token* cancellation_token, const std::shared_ptr<wamp_call>& call)
+{
+    if (progress_handler) {
+        call->set_progress_handler(progress_handler);
+    }
+
+    wamp_submission submission;
+    submission.m_message = std::move(message);
+    submission.m_request_id = request_id;
+    submission.m_timeout = timeout;
+    submission.m_call = call;
+
+    submit(std::move(submission));
+    if (cancellation_token) {
+        watch_cancellation(*cancellation_token, request_id);
+    }
+}
+
+inline void wamp_session::submit_subscribe(uint64_t request_id, wamp_message&& message,
+        const std::shared_ptr<wamp_subscribe_request>& subscribe_request)
+{
+    wamp_submission submission;
+    submission.m_message = std::move(message);
+    submission.m_request_id = request_id;
+    submission.m_subscribe_request = subscribe_request;
+
+    submit(std::move(submission));
+}
+
+inline void wamp_session::submit_register(uint64_t request_id, const std::shared_ptr<wamp_message>& message,
+        const std::shared_ptr<wamp_register_request>& register_request)
+{
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    boost::asio::dispatch(m_strand, [=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        drain_submissions(std::numeric_limits<std::size_t>::max());
+
+        try {
+            send_message(std::move(*message));
+            m_register_requests.insert(request_id, register_request);
+        } catch (const std::exception&) {
+            register_request->set_exception(std::current_exception());
+        }
+    });
+}
+
+inline bool wamp_session::join_topic_subscription(uint64_t request_id,
+        const std::shared_ptr<wamp_subscribe_request>& subscribe_request)
+{
+    auto key = std::make_pair(subscribe_request->match(), subscribe_request->topic());
+    auto itr = m_topic_subscriptions.find(key);
+    if (itr == m_topic_subscriptions.end()) {
+        // The first subscriber, which goes on to send the SUBSCRIBE.
+        m_topic_subscriptions.insert(std::make_pair(key, wamp_topic_subscription()));
+        return false;
+    }
+
+    wamp_topic_subscription& topic_subscription = itr->second;
+    if (topic_subscription.m_subscription_id == 0) {
+        topic_subscription.m_waiting.emplace_back(request_id, subscribe_request);
+    } else {
+        m_subscription_handlers.add(topic_subscription.m_subscription_id, request_id, subscribe_request->handler());
+        subscribe_request->set_response(wamp_subscription(topic_subscription.m_subscription_id, request_id));
+    }
+
+    return true;
+}
+
+inline void wamp_session::confirm_topic_subscription(uint64_t request_id,
+        const std::shared_ptr<wamp_subscribe_request>& subscribe_request, uint64_t subscription_id)
+{
+    std::vector<std::pair<uint64_t, std::shared_ptr<wamp_subscribe_request>>> subscribers;
+    subscribers.emplace_back(request_id, subscribe_request);
+
+    auto itr = m_topic_subscriptions.find(std::make_pair(subscribe_request->match(), subscribe_request->topic()));
+    if (itr != m_topic_subscriptions.end() && itr->second.m_subscription_id == 0) {
+        itr->second.m_subscription_id = subscription_id;
+        m_subscription_topics[subscription_id] = itr;
+
+        auto& waiting = itr->second.m_waiting;
+        subscribers.insert(subscribers.end(), waiting.begin(), waiting.end());
+        waiting.clear();
+    }
+
+    for (const auto& subscriber : subscribers) {
+        m_subscription_handlers.add(subscription_id, subscriber.first, subscriber.second->handler());
+    }
+
+    for (const auto& subscriber : subscribers) {
+        subscriber.second->set_response(wamp_subscription(subscription_id, subscriber.first));
+    }
+}
+
+template <typename Exception>
+inline void wamp_session::fail_topic_subscription(
+        const std::shared_ptr<wamp_subscribe_request>& subscribe_request, const Exception& exception)
+{
+    std::vector<std::pair<uint64_t, std::shared_ptr<wamp_subscribe_request>>> waiting;
+
+    // Forget the pending subscription, so that the next subscriber to the
+    // topic tries again with a fresh SUBSCRIBE.
+    auto itr = m_topic_subscriptions.find(std::make_pair(subscribe_request->match(), subscribe_request->topic()));
+    if (itr != m_topic_subscriptions.end() && itr->second.m_subscription_id == 0) {
+        waiting.swap(itr->second.m_waiting);
+        m_topic_subscriptions.erase(itr);
+    }
+
+    subscribe_request->set_exception(exception);
+    for (const auto& subscriber : waiting) {
+        subscriber.second->set_exception(exception);
+    }
+}
+
+inline void wamp_session::release_topic_subscription(uint64_t subscription_id)
+{
+    auto itr = m_subscription_topics.find(subscription_id);
+    if (itr != m_subscription_topics.end()) {
+        m_topic_subscriptions.erase(itr->second);
+        m_subscription_topics.erase(itr);
+    }
+}
+
+inline void wamp_session::reset_subscriptions()
+{
+    // Router subscriptions end with the session, so subscribing to the same
+    // topic after joining again has to go back to the router.
+    std::vector<std::shared_ptr<wamp_subscribe_request>> waiting;
+    for (auto& topic_subscription : m_topic_subscriptions) {
+        for (auto& subscriber : topic_subscription.second.m_waiting) {
+            waiting.push_back(std::move(subscriber.second));
+        }
+    }
+
+    m_topic_subscriptions.clear();
+    m_subscription_topics.clear();
+    m_subscription_handlers.clear();
+
+    for (const auto& subscribe_request : waiting) {
+        subscribe_request->set_exception(no_session_error());
+    }
+}
+
+inline void wamp_session::submit(wamp_submission&& submission)
+{
+    m_submissions.push(std::move(submission));
+
+    // Only the first submission since the queue was last drained needs to
+    // wake up the io service, the rest are picked up by the same drain.
+    if (!m_submissions_scheduled.exchange(true)) {
+        schedule_submissions();
+    }
+}
+
+inline void wamp_session::schedule_submissions()
+{
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    boost::asio::post(m_strand, [=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        process_submissions();
+    });
+}
+
+inline void wamp_session::process_submissions()
+{
+    // Cleared before draining so that a submission racing with the drain
+    // either gets popped below or schedules another drain.
+    m_submissions_scheduled = false;
+
+    if (drain_submissions(max_submissions_per_drain) == max_submissions_per_drain) {
+        // Give other handlers a turn before draining the rest.
+        if (!m_submissions_scheduled.exchange(true)) {
+            schedule_submissions();
+        }
+    }
+}
+
+inline std::size_t wamp_session::drain_submissions(std::size_t max_submissions)
+{
+    std::size_t num_submissions = 0;
+    wamp_submission submission;
+
+    while (num_submissions < max_submissions && m_submissions.pop(submission)) {
+        ++num_submissions;
+
+        // A subscription the router already has, or is about to confirm,
+        // only needs the handler added locally.
+        if (submission.m_subscribe_request &&
+                join_topic_subscription(submission.m_request_id, submission.m_subscribe_request)) {
+            continue;
+        }
+
+        try {
+            if (submission.m_batch_sent) {
+                send_messages(std::move(submission.m_batch));
+            } else {
+                send_message(std::move(submission.m_message));
+            }
+        } catch (const std::exception& e) {
+            if (submission.m_batch_sent) {
+                submission.m_batch_sent->set_exception(detail::to_boost_exception(std::current_exception()));
+            } else if (submission.m_published) {
+                submission.m_published->set_exception(std::current_exception());
+            } else if (submission.m_call) {
+                submission.m_call->set_exception(std::current_exception());
+            } else if (submission.m_subscribe_request) {
+                fail_topic_subscription(submission.m_subscribe_request, std::current_exception());
+            } else {
+                report_error(e);
+            }
+            continue;
+        }
+
+        if (submission.m_batch_sent) {
+            submission.m_batch_sent->set_value();
+        } else if (submission.m_published) {
+            if (submission.m_acknowledge) {
+                m_publish_requests.insert(submission.m_request_id, std::move(submission.m_published));
+            } else {
+                submission.m_published->set_value(wamp_publication());
+            }
+        } else if (submission.m_call) {
+            if (submission.m_timeout.count() > 0) {
+                schedule_call_timeout(*submission.m_call, submission.m_request_id, submission.m_timeout);
+            }
+            m_calls.insert(submission.m_request_id, std::move(submission.m_call));
+        } else if (submission.m_subscribe_request) {
+            m_subscribe_requests.insert(submission.m_request_id, std::move(submission.m_subscribe_request));
+        }
+    }
+
+    return num_submissions;
+}
+
+inline void wamp_session::fail_pending_requests()
+{
+    // None of these can complete without a transport. Failing them also
+    // releases the work that completion handlers keep on their executors,
+    // which would otherwise stop the io service from ever running out.
+    const no_transport_error error;
+
+    if (m_session_join) {
+        auto joined = std::move(m_session_join);
+        joined->set_exception(error);
+    }
+
+    if (m_session_leave) {
+        auto left = std::move(m_session_leave);
+        left->set_exception(error);
+    }
+
+    m_session_id = 0;
+    m_goodbye_sent = false;
+
+    fail_requests(m_calls, [&](const std::shared_ptr<wamp_call>& call) {
+        call->set_exception(error);
+    });
+    m_call_timer.cancel();
+    m_call_timer_expiry = wamp_timer_wheel::clock::time_point::max();
+
+    fail_requests(m_publish_requests, [&](const std::shared_ptr<wamp_completion<wamp_publication>>& published) {
+        published->set_exception(error);
+    });
+    fail_requests(m_subscribe_requests, [&](const std::shared_ptr<wamp_subscribe_request>& subscribe_request) {
+        subscribe_request->set_exception(error);
+    });
+    fail_requests(m_unsubscribe_requests, [&](const std::shared_ptr<wamp_unsubscribe_request>& unsubscribe_request) {
+        unsubscribe_request->response().set_exception(boost::copy_exception(error));
+    });
+    fail_requests(m_register_requests, [&](const std::shared_ptr<wamp_register_request>& register_request) {
+        register_request->set_exception(error);
+    });
+    fail_requests(m_unregister_requests, [&](const std::shared_ptr<wamp_unregister_request>& unregister_request) {
+        unregister_request->response().set_exception(boost::copy_exception(error));
+    });
+
+    reset_subscriptions();
+
+    // Registrations don't outlive the transport either, and invocations
+    // still queued for them can no longer be answered.
+    m_procedures.clear();
+
+    // Whatever is still waiting to be sent fails on its way out.
+    drain_submissions(std::numeric_limits<std::size_t>::max());
+}
+
+template <typename Request, typename Function>
+inline void wamp_session::fail_requests(wamp_request_table<Request>& requests, Function fail)
+{
+    // The table is emptied before anything fails, so that completions are
+    // free to make new requests.
+    wamp_request_table<Request> failed;
+    std::swap(failed, requests);
+
+    failed.for_each([&](uint64_t, const Request& request) {
+        fail(request);
+    });
+}
+
+inline void wamp_session::report_error(const std::exception& e)
+{
+    if (!m_error_handler) {
+        if (m_debug_enabled) {
+            std::cerr << "unreported error: " << e.what() << std::endl;
+        }
+        return;
+    }
+
+    try {
+        m_error_handler(e);
+    } catch (...) {
+        if (m_debug_enabled) {
+            std::cerr << "Warning: error handler threw exception" << std::endl;
+        }
+    }
+}
+
+inline void wamp_session::schedule_call_timeout(
+        wamp_call& call, uint64_t request_id, const std::chrono::milliseconds& timeout)
+{
+    m_call_timeouts.schedule(call.deadline(), request_id, wamp_timer_wheel::clock::now() + timeout);
+    arm_call_timer();
+}
+
+inline void wamp_session::arm_call_timer()
+{
+    // One timer serves however many calls there are. It is only moved
+    // when the wheel needs attention sooner than it is due to fire, and a
+    // wait that is moved completes with an error and does nothing.
+    const wamp_timer_wheel::clock::time_point next_event = m_call_timeouts.next_event();
+    if (next_event >= m_call_timer_expiry) {
+        return;
+    }
+
+    m_call_timer_expiry = next_event;
+    m_call_timer.expires_from_now(next_event - wamp_timer_wheel::clock::now());
+
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    m_call_timer.async_wait(boost::asio::bind_executor(m_strand, [=](const boost::system::error_code& error) {
+        auto shared_self = weak_self.lock();
+        if (!shared_self || error) {
+            return;
+        }
+
+        m_call_timer_expiry = wamp_timer_wheel::clock::time_point::max();
+
+        m_call_timeouts.advance(wamp_timer_wheel::clock::now(), [this](uint64_t request_id) {
+            expire_call(request_id);
+        });
+
+        arm_call_timer();
+    }));
+}
+
+inline void wamp_session::expire_call(uint64_t request_id)
+{
+    std::shared_ptr<wamp_call> call;
+    if (!m_calls.extract(request_id, call)) {
+        return;
+    }
+
+    call->set_exception(timeout_error("call timed out"));
+
+    if (m_router_call_canceling && m_session_id) {
+        send_cancel(request_id, wamp_cancel_mode::killnowait);
+    }
+}
+
+inline void wamp_session::watch_cancellation(const wamp_cancellation_token& cancellation_token, uint64_t request_id)
+{
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    cancellation_token.on_cancel([weak_self, request_id](wamp_cancel_mode mode) {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        boost::asio::dispatch(shared_self->m_strand, [weak_self, request_id, mode]() {
+            auto shared_self = weak_self.lock();
+            if (!shared_self) {
+                return;
+            }
+
+            shared_self->cancel_call(request_id, mode);
+        });
+    });
+}
+
+inline void wamp_session::cancel_call(uint64_t request_id, wamp_cancel_mode mode)
+{
+    // The call may still be waiting to be sent.
+    drain_submissions(std::numeric_limits<std::size_t>::max());
+
+    if (!m_calls.find(request_id)) {
+        return;
+    }
+
+    if (m_router_call_canceling && m_session_id) {
+        // The dealer fails the call with an ERROR once it has been cancelled.
+        send_cancel(request_id, mode);
+        return;
+    }
+
+    std::shared_ptr<wamp_call> call;
+    m_calls.extract(request_id, call);
+    m_call_timeouts.cancel(call->deadline());
+    call->set_exception(std::runtime_error("wamp.error.canceled"));
+}
+
+inline void wamp_session::send_cancel(uint64_t request_id, wamp_cancel_mode mode)
+{
+    // [CANCEL, CALL.Request|id, Options|dict]
+    auto buffer = acquire_buffer(m_buffer_pool);
+    std::map<std::string, std::string> options;
+    options["mode"] = to_string(mode);
+    serialize_message(*buffer, static_cast<int>(message_type::CANCEL), request_id, options);
+
+    try {
+        send_message(wamp_message(std::move(buffer)));
+    } catch (const std::exception& e) {
+        if (m_debug_enabled) {
+            std::cerr << "failed to send CANCEL: " << e.what() << std::endl;
+        }
+    }
+}
+
+inline bool wamp_session::has_feature(
+        const msgpack::object& details, const std::string& role, const std::string& feature)
+{
+    // Details|dict = {"roles": {<role>: {"features": {<feature>: true}}}}
+    try {
+        std::unordered_map<std::string, msgpack::object> details_map;
+        details.convert(details_map);
+
+        auto roles_itr = details_map.find("roles");
+        if (roles_itr == details_map.end()) {
+            return false;
+        }
+
+        std::unordered_map<std::string, msgpack::object> roles;
+        roles_itr->second.convert(roles);
+
+        auto role_itr = roles.find(role);
+        if (role_itr == roles.end()) {
+            return false;
+        }
+
+        std::unordered_map<std::string, msgpack::object> role_details;
+        role_itr->second.convert(role_details);
+
+        auto features_itr = role_details.find("features");
+        if (features_itr == role_details.end()) {
+            return false;
+        }
+
+        std::unordered_map<std::string, msgpack::object> features;
+        features_itr->second.convert(features);
+
+        auto feature_itr = features.find(feature);
+        return feature_itr != features.end() && feature_itr->second.as<bool>();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+inline void wamp_session::on_transport_paused()
+{
+    m_writable = false;
+}
+
+inline void wamp_session::on_transport_resumed()
+{
+    m_writable = true;
+
+    std::vector<std::shared_ptr<boost::promise<void>>> waiters;
+    waiters.swap(m_writable_waiters);
+    for (auto& waiter : waiters) {
+        waiter->set_value();
+    }
 }
 
 inline const std::unordered_map<std::string, msgpack::object>&  wamp_session::welcome_details()
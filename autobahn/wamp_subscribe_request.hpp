@@ -31,10 +31,13 @@
 #ifndef AUTOBAHN_WAMP_SUBSCRIBE_REQUEST_HPP
 #define AUTOBAHN_WAMP_SUBSCRIBE_REQUEST_HPP
 
+#include "wamp_completion_handler.hpp"
 #include "wamp_event_handler.hpp"
 #include "wamp_subscription.hpp"
 #include "boost_config.hpp"
 
+#include <string>
+
 namespace autobahn {
 
 /// An outstanding wamp call.
@@ -43,15 +46,46 @@ class wamp_subscribe_request
 public:
     wamp_subscribe_request();
     wamp_subscribe_request(const wamp_event_handler& handler);
+    wamp_subscribe_request(const wamp_event_handler& handler,
+            const std::string& topic, const std::string& match);
 
     const wamp_event_handler& handler() const;
+
+    /*!
+     * The topic and match policy, which together identify the router
+     * subscription that the handler can share with other local handlers.
+     */
+    const std::string& topic() const;
+    const std::string& match() const;
+
     boost::promise<wamp_subscription>& response();
     void set_handler(const wamp_event_handler& handler) const;
     void set_response(const wamp_subscription& subscription);
 
+    /*!
+     * Fails the request, through the completion handler if there is one
+     * and through the promise otherwise.
+     */
+    template <typename Exception>
+    void set_exception(const Exception& exception);
+
+    /*!
+     * Fails the request with an exception captured by std::current_exception(),
+     * keeping its type.
+     */
+    void set_exception(std::exception_ptr exception);
+
+    /*!
+     * Completes the request through the given handler instead of the promise.
+     */
+    void set_completion_handler(const wamp_completion_handler<wamp_subscription>& handler);
+
 private:
     wamp_event_handler m_handler;
+    std::string m_topic;
+    std::string m_match;
     boost::promise<wamp_subscription> m_response;
+    wamp_completion_handler<wamp_subscription> m_completion_handler;
 };
 
 } // namespace autobahn
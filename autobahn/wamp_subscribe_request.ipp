@@ -32,13 +32,29 @@ namespace autobahn {
 
 inline wamp_subscribe_request::wamp_subscribe_request()
     : m_handler()
+    , m_topic()
+    , m_match()
     , m_response()
+    , m_completion_handler()
 {
 }
 
 inline wamp_subscribe_request::wamp_subscribe_request(const wamp_event_handler& handler)
     : m_handler(handler)
+    , m_topic()
+    , m_match()
     , m_response()
+    , m_completion_handler()
+{
+}
+
+inline wamp_subscribe_request::wamp_subscribe_request(const wamp_event_handler& handler,
+        const std::string& topic, const std::string& match)
+    : m_handler(handler)
+    , m_topic(topic)
+    , m_match(match)
+    , m_response()
+    , m_completion_handler()
 {
 }
 
@@ -47,6 +63,16 @@ inline const wamp_event_handler& wamp_subscribe_request::handler() const
     return m_handler;
 }
 
+inline const std::string& wamp_subscribe_request::topic() const
+{
+    return m_topic;
+}
+
+inline const std::string& wamp_subscribe_request::match() const
+{
+    return m_match;
+}
+
 inline boost::promise<wamp_subscription>& wamp_subscribe_request::response()
 {
     return m_response;
@@ -54,7 +80,35 @@ inline boost::promise<wamp_subscription>& wamp_subscribe_request::response()
 
 inline void wamp_subscribe_request::set_response(const wamp_subscription& subscription)
 {
-    m_response.set_value(subscription);
+    if (m_completion_handler) {
+        m_completion_handler(nullptr, subscription);
+    } else {
+        m_response.set_value(subscription);
+    }
+}
+
+template <typename Exception>
+inline void wamp_subscribe_request::set_exception(const Exception& exception)
+{
+    if (m_completion_handler) {
+        m_completion_handler(std::make_exception_ptr(exception), wamp_subscription());
+    } else {
+        m_response.set_exception(boost::copy_exception(exception));
+    }
+}
+
+inline void wamp_subscribe_request::set_exception(std::exception_ptr exception)
+{
+    if (m_completion_handler) {
+        m_completion_handler(exception, wamp_subscription());
+    } else {
+        m_response.set_exception(detail::to_boost_exception(exception));
+    }
+}
+
+inline void wamp_subscribe_request::set_completion_handler(const wamp_completion_handler<wamp_subscription>& handler)
+{
+    m_completion_handler = handler;
 }
 
 } // namespace autobahn
@@ -41,10 +41,23 @@ class wamp_subscription
 public:
     wamp_subscription();
     wamp_subscription(uint64_t id);
+    wamp_subscription(uint64_t id, uint64_t handler_id);
+
+    /*!
+     * The subscription id assigned by the router, which is shared by all
+     * local handlers subscribed to the same topic with the same options.
+     */
     uint64_t id() const;
 
+    /*!
+     * Identifies the local handler within the subscription, or zero if
+     * the subscription refers to all of its handlers.
+     */
+    uint64_t handler_id() const;
+
 private:
     uint64_t m_id;
+    uint64_t m_handler_id;
 };
 
 } // namespace autobahn
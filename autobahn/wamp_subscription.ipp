@@ -32,11 +32,19 @@ namespace autobahn {
 
 inline wamp_subscription::wamp_subscription()
     : m_id(0)
+    , m_handler_id(0)
 {
 }
 
 inline wamp_subscription::wamp_subscription(uint64_t id)
     : m_id(id)
+    , m_handler_id(0)
+{
+}
+
+inline wamp_subscription::wamp_subscription(uint64_t id, uint64_t handler_id)
+    : m_id(id)
+    , m_handler_id(handler_id)
 {
 }
 
@@ -45,4 +53,9 @@ inline uint64_t wamp_subscription::id() const
     return m_id;
 }
 
+inline uint64_t wamp_subscription::handler_id() const
+{
+    return m_handler_id;
+}
+
 } // namespace autobahn
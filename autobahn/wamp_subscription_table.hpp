@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_SUBSCRIPTION_TABLE_HPP
+#define AUTOBAHN_WAMP_SUBSCRIPTION_TABLE_HPP
+
+#include "wamp_event_handler.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * The handlers for a single subscription. Nearly every subscription has
+ * exactly one handler, so the first one is stored inline and only further
+ * handlers are kept in a separately allocated vector.
+ *
+ * Each handler is tagged with an id so that it can be removed on its own
+ * while the others keep receiving events.
+ */
+class wamp_event_handlers
+{
+public:
+    wamp_event_handlers();
+
+    void push_back(uint64_t handler_id, const wamp_event_handler& handler);
+
+    /*!
+     * Removes a single handler, keeping the order of the others.
+     *
+     * @param handler_id The id the handler was added with.
+     *
+     * @return Whether the handler was found.
+     */
+    bool erase(uint64_t handler_id);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    const wamp_event_handler& operator[](std::size_t index) const;
+
+private:
+    typedef std::pair<uint64_t, wamp_event_handler> entry;
+
+    entry m_first;
+    std::vector<entry> m_rest;
+    std::size_t m_size;
+};
+
+/*!
+ * Maps subscription ids to their event handlers. The table is open
+ * addressed with linear probing over buckets that hold just an id and a
+ * pointer to the handlers, so the probes for an event usually stay within
+ * one or two cache lines rather than walking a tree.
+ *
+ * Removal shifts later entries of a probe sequence back rather than
+ * leaving tombstones, so lookups never slow down as subscriptions come
+ * and go.
+ *
+ * The handlers of a subscription are shared and never modified in place;
+ * adding or removing one replaces the whole list. An event being
+ * delivered therefore keeps the list it started with, even when one of
+ * its handlers subscribes or unsubscribes.
+ */
+class wamp_subscription_table
+{
+public:
+    /*!
+     * Constructs an empty table.
+     *
+     * @param initial_capacity The initial number of buckets, which is
+     *                         rounded up to a power of two.
+     */
+    explicit wamp_subscription_table(std::size_t initial_capacity = 16);
+
+    /*!
+     * Adds a handler for a subscription.
+     *
+     * @param subscription_id The non-zero subscription id.
+     * @param handler_id An id for the handler that is unique within the
+     *                   subscription.
+     * @param handler The event handler.
+     */
+    void add(uint64_t subscription_id, uint64_t handler_id, const wamp_event_handler& handler);
+
+    /*!
+     * Removes all handlers for a subscription.
+     *
+     * @param subscription_id The subscription id.
+     *
+     * @return Whether there were any handlers for the subscription.
+     */
+    bool remove(uint64_t subscription_id);
+
+    /*!
+     * Removes a single handler for a subscription, and the subscription
+     * itself along with its last handler.
+     *
+     * @param subscription_id The subscription id.
+     * @param handler_id The id the handler was added with.
+     *
+     * @return Whether the handler was found.
+     */
+    bool remove(uint64_t subscription_id, uint64_t handler_id);
+
+    /*!
+     * Looks up the handlers for a subscription.
+     *
+     * @param subscription_id The subscription id.
+     *
+     * @return The handlers, or null if there are none for the subscription.
+     */
+    std::shared_ptr<const wamp_event_handlers> find(uint64_t subscription_id) const;
+
+    /*!
+     * Removes all subscriptions.
+     */
+    void clear();
+
+    /*!
+     * The number of subscriptions with handlers.
+     */
+    std::size_t size() const;
+
+private:
+    /*!
+     * Kept to an id and a pointer, 24 bytes on 64-bit platforms, so that
+     * neighbouring buckets share cache lines.
+     */
+    struct bucket
+    {
+        bucket() : m_subscription_id(0), m_handlers() {}
+
+        /*!
+         * The subscription id, or zero if the bucket is empty.
+         */
+        uint64_t m_subscription_id;
+        std::shared_ptr<const wamp_event_handlers> m_handlers;
+    };
+
+    std::size_t home_bucket(uint64_t subscription_id) const;
+    std::size_t find_bucket(uint64_t subscription_id) const;
+    void grow();
+
+private:
+    /*!
+     * The buckets, whose number is always a power of two. The table is
+     * never more than three quarters full, so every probe sequence ends
+     * at an empty bucket.
+     */
+    std::vector<bucket> m_buckets;
+
+    /*!
+     * The number of occupied buckets.
+     */
+    std::size_t m_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_subscription_table.ipp"
+
+#endif // AUTOBAHN_WAMP_SUBSCRIPTION_TABLE_HPP
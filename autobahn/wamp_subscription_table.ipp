@@ -0,0 +1,229 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+
+namespace autobahn {
+
+inline wamp_event_handlers::wamp_event_handlers()
+    : m_first()
+    , m_rest()
+    , m_size(0)
+{
+}
+
+inline void wamp_event_handlers::push_back(uint64_t handler_id, const wamp_event_handler& handler)
+{
+    if (m_size == 0) {
+        m_first = entry(handler_id, handler);
+    } else {
+        m_rest.push_back(entry(handler_id, handler));
+    }
+
+    ++m_size;
+}
+
+inline bool wamp_event_handlers::erase(uint64_t handler_id)
+{
+    if (m_size == 0) {
+        return false;
+    }
+
+    if (m_first.first == handler_id) {
+        if (m_rest.empty()) {
+            m_first = entry();
+        } else {
+            m_first = std::move(m_rest.front());
+            m_rest.erase(m_rest.begin());
+        }
+    } else {
+        auto itr = m_rest.begin();
+        while (itr != m_rest.end() && itr->first != handler_id) {
+            ++itr;
+        }
+        if (itr == m_rest.end()) {
+            return false;
+        }
+        m_rest.erase(itr);
+    }
+
+    --m_size;
+    return true;
+}
+
+inline std::size_t wamp_event_handlers::size() const
+{
+    return m_size;
+}
+
+inline bool wamp_event_handlers::empty() const
+{
+    return m_size == 0;
+}
+
+inline const wamp_event_handler& wamp_event_handlers::operator[](std::size_t index) const
+{
+    return index == 0 ? m_first.second : m_rest[index - 1].second;
+}
+
+inline wamp_subscription_table::wamp_subscription_table(std::size_t initial_capacity)
+    : m_buckets()
+    , m_size(0)
+{
+    std::size_t capacity = 4;
+    while (capacity < initial_capacity) {
+        capacity <<= 1;
+    }
+
+    m_buckets.resize(capacity);
+}
+
+inline void wamp_subscription_table::add(
+        uint64_t subscription_id, uint64_t handler_id, const wamp_event_handler& handler)
+{
+    std::size_t index = find_bucket(subscription_id);
+    if (m_buckets[index].m_subscription_id == 0) {
+        if ((m_size + 1) * 4 > m_buckets.size() * 3) {
+            grow();
+            index = find_bucket(subscription_id);
+        }
+
+        m_buckets[index].m_subscription_id = subscription_id;
+        ++m_size;
+    }
+
+    bucket& found = m_buckets[index];
+    auto handlers = found.m_handlers
+            ? std::make_shared<wamp_event_handlers>(*found.m_handlers)
+            : std::make_shared<wamp_event_handlers>();
+    handlers->push_back(handler_id, handler);
+    found.m_handlers = std::move(handlers);
+}
+
+inline bool wamp_subscription_table::remove(uint64_t subscription_id)
+{
+    std::size_t index = find_bucket(subscription_id);
+    if (m_buckets[index].m_subscription_id == 0) {
+        return false;
+    }
+
+    // Shift back any following entries that would no longer be reachable
+    // from their home bucket once this one is emptied.
+    const std::size_t mask = m_buckets.size() - 1;
+    std::size_t next = (index + 1) & mask;
+    while (m_buckets[next].m_subscription_id != 0) {
+        std::size_t home = home_bucket(m_buckets[next].m_subscription_id);
+        if (((next - home) & mask) >= ((next - index) & mask)) {
+            m_buckets[index] = std::move(m_buckets[next]);
+            index = next;
+        }
+        next = (next + 1) & mask;
+    }
+
+    m_buckets[index] = bucket();
+    --m_size;
+
+    return true;
+}
+
+inline bool wamp_subscription_table::remove(uint64_t subscription_id, uint64_t handler_id)
+{
+    bucket& found = m_buckets[find_bucket(subscription_id)];
+    if (found.m_subscription_id == 0) {
+        return false;
+    }
+
+    auto handlers = std::make_shared<wamp_event_handlers>(*found.m_handlers);
+    if (!handlers->erase(handler_id)) {
+        return false;
+    }
+
+    if (handlers->empty()) {
+        remove(subscription_id);
+    } else {
+        found.m_handlers = std::move(handlers);
+    }
+
+    return true;
+}
+
+inline std::shared_ptr<const wamp_event_handlers> wamp_subscription_table::find(uint64_t subscription_id) const
+{
+    return m_buckets[find_bucket(subscription_id)].m_handlers;
+}
+
+inline void wamp_subscription_table::clear()
+{
+    for (auto& current : m_buckets) {
+        current = bucket();
+    }
+
+    m_size = 0;
+}
+
+inline std::size_t wamp_subscription_table::size() const
+{
+    return m_size;
+}
+
+inline std::size_t wamp_subscription_table::home_bucket(uint64_t subscription_id) const
+{
+    // Fibonacci hashing spreads ids that share their low bits, such as
+    // sequentially assigned ones, across the whole table.
+    return static_cast<std::size_t>(
+            (subscription_id * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (m_buckets.size() - 1);
+}
+
+inline std::size_t wamp_subscription_table::find_bucket(uint64_t subscription_id) const
+{
+    const std::size_t mask = m_buckets.size() - 1;
+
+    std::size_t index = home_bucket(subscription_id);
+    while (m_buckets[index].m_subscription_id != 0 &&
+            m_buckets[index].m_subscription_id != subscription_id) {
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+inline void wamp_subscription_table::grow()
+{
+    std::vector<bucket> buckets(m_buckets.size() * 2);
+    std::swap(m_buckets, buckets);
+
+    for (auto& current : buckets) {
+        if (current.m_subscription_id != 0) {
+            m_buckets[find_bucket(current.m_subscription_id)] = std::move(current);
+        }
+    }
+}
+
+} // namespace autobahn
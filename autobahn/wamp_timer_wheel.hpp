@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TIMER_WHEEL_HPP
+#define AUTOBAHN_WAMP_TIMER_WHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace autobahn {
+
+class wamp_timer_wheel;
+
+/*!
+ * A deadline that can be scheduled on a wamp_timer_wheel. The entry is
+ * linked into the wheel in place, so scheduling and cancelling never
+ * allocate. An entry is cancelled automatically when it is destroyed.
+ */
+class wamp_timer_wheel_entry
+{
+public:
+    wamp_timer_wheel_entry();
+    ~wamp_timer_wheel_entry();
+
+    wamp_timer_wheel_entry(const wamp_timer_wheel_entry& other) = delete;
+    wamp_timer_wheel_entry& operator=(const wamp_timer_wheel_entry& other) = delete;
+
+    /*!
+     * Determines whether the entry is currently scheduled.
+     */
+    bool is_scheduled() const;
+
+private:
+    friend class wamp_timer_wheel;
+
+    void link_before(wamp_timer_wheel_entry* next);
+    void unlink();
+
+private:
+    wamp_timer_wheel_entry* m_prev;
+    wamp_timer_wheel_entry* m_next;
+
+    /*!
+     * The wheel the entry is scheduled on, if any.
+     */
+    wamp_timer_wheel* m_wheel;
+
+    /*!
+     * The identifier handed back when the entry expires.
+     */
+    uint64_t m_id;
+
+    /*!
+     * The tick at which the entry expires.
+     */
+    uint64_t m_expiry_tick;
+};
+
+/*!
+ * A hierarchical timer wheel for tracking large numbers of deadlines
+ * with a single timer. Time advances in ticks of a fixed resolution.
+ * The wheel has four levels of 64 slots each, where a slot on one level
+ * spans a whole lap of the level below it, so deadlines up to 64^4 ticks
+ * ahead are tracked directly. Scheduling, cancelling and expiring an
+ * entry are all constant time. Entries on the upper levels are moved
+ * down a level each time the level below completes a lap.
+ *
+ * The wheel is not thread safe and only ever fires entries from within
+ * advance(), so the owner decides what drives it. Ticks without any work
+ * are skipped rather than walked, so the owner only needs to wake up at
+ * next_event().
+ */
+class wamp_timer_wheel
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    /*!
+     * Constructs an empty wheel.
+     *
+     * @param resolution The duration of a tick. Deadlines are rounded up
+     *                   to the next tick.
+     */
+    explicit wamp_timer_wheel(
+            const std::chrono::milliseconds& resolution = std::chrono::milliseconds(10));
+
+    ~wamp_timer_wheel();
+
+    wamp_timer_wheel(const wamp_timer_wheel& other) = delete;
+    wamp_timer_wheel& operator=(const wamp_timer_wheel& other) = delete;
+
+    /*!
+     * Schedules an entry, rescheduling it if it is already scheduled.
+     *
+     * @param entry The entry to schedule.
+     * @param id The identifier handed back when the entry expires.
+     * @param deadline The time at which the entry expires.
+     */
+    void schedule(wamp_timer_wheel_entry& entry, uint64_t id, const clock::time_point& deadline);
+
+    /*!
+     * Cancels an entry. Does nothing if the entry is not scheduled.
+     *
+     * @param entry The entry to cancel.
+     */
+    void cancel(wamp_timer_wheel_entry& entry);
+
+    /*!
+     * Advances the wheel up to the given time, expiring every entry
+     * whose deadline has passed. Expired entries are no longer scheduled
+     * by the time the function is invoked, so it may safely schedule or
+     * cancel entries, including the expired one.
+     *
+     * @param now The current time.
+     * @param function Invoked with the identifier of each expired entry.
+     */
+    template <typename Function>
+    void advance(const clock::time_point& now, Function function);
+
+    /*!
+     * The earliest time at which advance() has work to do, which is either
+     * an entry expiring or entries moving down a level. Checks a bounded
+     * number of slots, however far ahead the deadlines are.
+     *
+     * @return The time, or clock::time_point::max() if no entries are
+     *         scheduled.
+     */
+    clock::time_point next_event() const;
+
+    /*!
+     * The duration of a tick.
+     */
+    const std::chrono::milliseconds& resolution() const;
+
+    /*!
+     * The number of scheduled entries.
+     */
+    std::size_t size() const;
+
+    /*!
+     * Determines whether there are no scheduled entries.
+     */
+    bool empty() const;
+
+private:
+    friend class wamp_timer_wheel_entry;
+
+    static const unsigned slot_bits = 6;
+    static const std::size_t slots_per_level = std::size_t(1) << slot_bits;
+    static const std::size_t num_levels = 4;
+
+    // Deadlines round up to the tick they fall in and the current time
+    // rounds down, so that nothing ever expires before its deadline.
+    uint64_t deadline_tick(const clock::time_point& deadline) const;
+    uint64_t elapsed_tick(const clock::time_point& now) const;
+    uint64_t next_event_tick() const;
+    void insert(wamp_timer_wheel_entry& entry);
+    wamp_timer_wheel_entry& slot(std::size_t level, std::size_t index);
+    const wamp_timer_wheel_entry& slot(std::size_t level, std::size_t index) const;
+
+    template <typename Function>
+    void expire_slot(wamp_timer_wheel_entry& head, Function function);
+    void cascade_slot(wamp_timer_wheel_entry& head);
+
+private:
+    std::chrono::milliseconds m_resolution;
+
+    /*!
+     * The time of tick zero.
+     */
+    clock::time_point m_start;
+
+    /*!
+     * The last tick that has been processed.
+     */
+    uint64_t m_current_tick;
+
+    /*!
+     * The list heads of all slots, level by level. The heads are never
+     * reallocated since scheduled entries point at them.
+     */
+    std::vector<wamp_timer_wheel_entry> m_slots;
+
+    std::size_t m_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_timer_wheel.ipp"
+
+#endif // AUTOBAHN_WAMP_TIMER_WHEEL_HPP
@@ -0,0 +1,303 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_timer_wheel_entry::wamp_timer_wheel_entry()
+    : m_prev(nullptr)
+    , m_next(nullptr)
+    , m_wheel(nullptr)
+    , m_id(0)
+    , m_expiry_tick(0)
+{
+}
+
+inline wamp_timer_wheel_entry::~wamp_timer_wheel_entry()
+{
+    if (m_wheel) {
+        m_wheel->cancel(*this);
+    }
+}
+
+inline bool wamp_timer_wheel_entry::is_scheduled() const
+{
+    return m_wheel != nullptr;
+}
+
+inline void wamp_timer_wheel_entry::link_before(wamp_timer_wheel_entry* next)
+{
+    m_next = next;
+    m_prev = next->m_prev;
+    m_prev->m_next = this;
+    next->m_prev = this;
+}
+
+inline void wamp_timer_wheel_entry::unlink()
+{
+    m_prev->m_next = m_next;
+    m_next->m_prev = m_prev;
+    m_prev = nullptr;
+    m_next = nullptr;
+}
+
+inline wamp_timer_wheel::wamp_timer_wheel(const std::chrono::milliseconds& resolution)
+    : m_resolution(resolution.count() > 0 ? resolution : std::chrono::milliseconds(1))
+    , m_start(clock::now())
+    , m_current_tick(0)
+    , m_slots(num_levels * slots_per_level)
+    , m_size(0)
+{
+    for (auto& head : m_slots) {
+        head.m_prev = &head;
+        head.m_next = &head;
+    }
+}
+
+inline wamp_timer_wheel::~wamp_timer_wheel()
+{
+    // Detach whatever is still scheduled so that the entries do not try
+    // to unlink themselves from a wheel that no longer exists.
+    for (auto& head : m_slots) {
+        while (head.m_next != &head) {
+            wamp_timer_wheel_entry* entry = head.m_next;
+            entry->unlink();
+            entry->m_wheel = nullptr;
+        }
+    }
+}
+
+inline void wamp_timer_wheel::schedule(
+        wamp_timer_wheel_entry& entry, uint64_t id, const clock::time_point& deadline)
+{
+    cancel(entry);
+
+    // Nothing advances the wheel while it is empty, so catch up with the
+    // clock first rather than placing the entry against a stale tick.
+    if (m_size == 0) {
+        const uint64_t now_tick = elapsed_tick(clock::now());
+        if (now_tick > m_current_tick) {
+            m_current_tick = now_tick;
+        }
+    }
+
+    uint64_t expiry_tick = deadline_tick(deadline);
+    if (expiry_tick <= m_current_tick) {
+        expiry_tick = m_current_tick + 1;
+    }
+
+    entry.m_id = id;
+    entry.m_expiry_tick = expiry_tick;
+    entry.m_wheel = this;
+    insert(entry);
+
+    ++m_size;
+}
+
+inline void wamp_timer_wheel::cancel(wamp_timer_wheel_entry& entry)
+{
+    if (entry.m_wheel != this) {
+        return;
+    }
+
+    entry.unlink();
+    entry.m_wheel = nullptr;
+
+    --m_size;
+}
+
+template <typename Function>
+inline void wamp_timer_wheel::advance(const clock::time_point& now, Function function)
+{
+    const uint64_t target_tick = elapsed_tick(now);
+
+    while (m_current_tick < target_tick) {
+        const uint64_t next_tick = next_event_tick();
+        if (next_tick > target_tick) {
+            m_current_tick = target_tick;
+            break;
+        }
+        m_current_tick = next_tick;
+
+        // Whenever a level completes a lap, the next slot of the level
+        // above is spread out over the levels below it. The highest level
+        // goes first so that its entries can trickle all the way down.
+        std::size_t num_cascades = 0;
+        while (num_cascades + 1 < num_levels &&
+                (m_current_tick & ((uint64_t(1) << (slot_bits * (num_cascades + 1))) - 1)) == 0) {
+            ++num_cascades;
+        }
+
+        for (std::size_t level = num_cascades; level > 0; --level) {
+            std::size_t index = static_cast<std::size_t>(
+                    (m_current_tick >> (slot_bits * level)) & (slots_per_level - 1));
+            cascade_slot(slot(level, index));
+        }
+
+        std::size_t index = static_cast<std::size_t>(m_current_tick & (slots_per_level - 1));
+        expire_slot(slot(0, index), function);
+    }
+}
+
+inline wamp_timer_wheel::clock::time_point wamp_timer_wheel::next_event() const
+{
+    const uint64_t tick = next_event_tick();
+    if (tick == std::numeric_limits<uint64_t>::max()) {
+        return clock::time_point::max();
+    }
+
+    return m_start + std::chrono::duration_cast<clock::duration>(m_resolution) * tick;
+}
+
+inline const std::chrono::milliseconds& wamp_timer_wheel::resolution() const
+{
+    return m_resolution;
+}
+
+inline std::size_t wamp_timer_wheel::size() const
+{
+    return m_size;
+}
+
+inline bool wamp_timer_wheel::empty() const
+{
+    return m_size == 0;
+}
+
+inline uint64_t wamp_timer_wheel::deadline_tick(const clock::time_point& deadline) const
+{
+    if (deadline <= m_start) {
+        return 0;
+    }
+
+    const clock::duration resolution = m_resolution;
+    return static_cast<uint64_t>((deadline - m_start + resolution - clock::duration(1)) / resolution);
+}
+
+inline uint64_t wamp_timer_wheel::elapsed_tick(const clock::time_point& now) const
+{
+    if (now <= m_start) {
+        return 0;
+    }
+
+    const clock::duration resolution = m_resolution;
+    return static_cast<uint64_t>((now - m_start) / resolution);
+}
+
+inline uint64_t wamp_timer_wheel::next_event_tick() const
+{
+    uint64_t next_tick = std::numeric_limits<uint64_t>::max();
+    if (m_size == 0) {
+        return next_tick;
+    }
+
+    // Level 0 expires the slot of every tick, while a higher level only
+    // acts on the ticks where the level below completes a lap. Either way
+    // a level has at most one lap's worth of slots to look at.
+    for (std::size_t level = 0; level < num_levels; ++level) {
+        const unsigned shift = slot_bits * static_cast<unsigned>(level);
+        uint64_t tick = ((m_current_tick >> shift) + 1) << shift;
+
+        for (std::size_t step = 0; step < slots_per_level && tick < next_tick; ++step) {
+            std::size_t index = static_cast<std::size_t>((tick >> shift) & (slots_per_level - 1));
+            const wamp_timer_wheel_entry& head = slot(level, index);
+            if (head.m_next != &head) {
+                next_tick = tick;
+                break;
+            }
+            tick += uint64_t(1) << shift;
+        }
+    }
+
+    return next_tick;
+}
+
+inline void wamp_timer_wheel::insert(wamp_timer_wheel_entry& entry)
+{
+    const uint64_t delta = entry.m_expiry_tick - m_current_tick;
+
+    std::size_t level = 0;
+    while (level + 1 < num_levels && delta >= (uint64_t(1) << (slot_bits * (level + 1)))) {
+        ++level;
+    }
+
+    // Deadlines beyond the reach of the top level park in its furthest
+    // slot and are placed again once that slot cascades.
+    uint64_t tick = entry.m_expiry_tick;
+    if (delta >= (uint64_t(1) << (slot_bits * num_levels))) {
+        tick = m_current_tick + (uint64_t(1) << (slot_bits * num_levels)) - 1;
+    }
+
+    std::size_t index = static_cast<std::size_t>((tick >> (slot_bits * level)) & (slots_per_level - 1));
+    entry.link_before(&slot(level, index));
+}
+
+inline wamp_timer_wheel_entry& wamp_timer_wheel::slot(std::size_t level, std::size_t index)
+{
+    return m_slots[level * slots_per_level + index];
+}
+
+inline const wamp_timer_wheel_entry& wamp_timer_wheel::slot(std::size_t level, std::size_t index) const
+{
+    return m_slots[level * slots_per_level + index];
+}
+
+template <typename Function>
+inline void wamp_timer_wheel::expire_slot(wamp_timer_wheel_entry& head, Function function)
+{
+    while (head.m_next != &head) {
+        wamp_timer_wheel_entry* entry = head.m_next;
+        uint64_t id = entry->m_id;
+
+        cancel(*entry);
+        function(id);
+    }
+}
+
+inline void wamp_timer_wheel::cascade_slot(wamp_timer_wheel_entry& head)
+{
+    // Detach the whole slot first, since entries may land back in it.
+    wamp_timer_wheel_entry pending;
+    pending.m_prev = &pending;
+    pending.m_next = &pending;
+
+    while (head.m_next != &head) {
+        wamp_timer_wheel_entry* entry = head.m_next;
+        entry->unlink();
+        entry->link_before(&pending);
+    }
+
+    while (pending.m_next != &pending) {
+        wamp_timer_wheel_entry* entry = pending.m_next;
+        entry->unlink();
+        insert(*entry);
+    }
+}
+
+} // namespace autobahn
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TOPIC_TRIE_HPP
+#define AUTOBAHN_WAMP_TOPIC_TRIE_HPP
+
+#include "wamp_event.hpp"
+#include "wamp_event_handler.hpp"
+
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * Routes events to local handlers by their concrete topic, so that a single
+ * broad prefix or wildcard subscription at the router can serve many local
+ * subscribers. The handlers take the same patterns the router does:
+ *
+ * - "exact" matches the topic itself.
+ * - "prefix" matches every topic starting with the pattern.
+ * - "wildcard" matches topics with the same number of components, where an
+ *   empty component of the pattern matches any component.
+ *
+ * The trie is keyed by URI component, so routing an event only visits the
+ * branches its topic can match, however many handlers there are. The topic
+ * is walked in place, so routing an event doesn't allocate.
+ *
+ * Example:
+ * ```
+ * auto trie = std::make_shared<autobahn::wamp_topic_trie>();
+ * trie->add("com.myapp.device.42.status", &on_status);
+ * session->subscribe("com.myapp.device", [trie](const autobahn::wamp_event& event) {
+ *     trie->dispatch(event);
+ * }, autobahn::wamp_subscribe_options("prefix"));
+ * ```
+ *
+ * The trie isn't synchronized. When the session's io service is run by
+ * several threads, add and remove handlers on the session's strand. Handlers
+ * must not add or remove handlers while an event is being dispatched.
+ */
+class wamp_topic_trie
+{
+public:
+    wamp_topic_trie();
+
+    wamp_topic_trie(const wamp_topic_trie& other) = delete;
+    wamp_topic_trie& operator=(const wamp_topic_trie& other) = delete;
+
+    /*!
+     * Adds a handler for the topics matching a pattern.
+     *
+     * @param pattern The topic pattern.
+     * @param handler The handler to call for matching events.
+     * @param match One of "exact", "prefix" or "wildcard".
+     *
+     * @return A handle through which the handler can be removed.
+     */
+    std::size_t add(
+            const std::string& pattern,
+            const wamp_event_handler& handler,
+            const std::string& match = "exact");
+
+    /*!
+     * Removes a handler.
+     *
+     * @param handle The handle returned when the handler was added.
+     *
+     * @return Whether there was such a handler.
+     */
+    bool remove(std::size_t handle);
+
+    /*!
+     * Calls the handlers whose patterns match the event's topic. An
+     * exception thrown by one handler doesn't keep the others from being
+     * called. The first one is rethrown once they have all been called, so
+     * that it reaches whatever called dispatch(), such as the session.
+     *
+     * @param event The event, which has to carry its topic, see
+     *              wamp_event_impl::uri().
+     *
+     * @return The number of handlers called.
+     */
+    std::size_t dispatch(const wamp_event& event) const;
+
+    /*!
+     * The number of handlers.
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+private:
+    struct prefix_handler
+    {
+        std::size_t m_handle;
+
+        // The part of the pattern after its last complete component,
+        // which the rest of the topic has to start with.
+        std::string m_tail;
+        wamp_event_handler m_handler;
+    };
+
+    struct node
+    {
+        // Children by URI component, sorted so that a component can be
+        // looked up where it is in the topic. The empty component, which
+        // is always first, leads to the handlers of wildcard patterns.
+        std::vector<std::pair<std::string, std::unique_ptr<node>>> m_children;
+
+        // Handlers of exact and wildcard patterns ending at this node.
+        std::vector<std::pair<std::size_t, wamp_event_handler>> m_handlers;
+
+        // Handlers of prefix patterns whose complete components end here.
+        std::vector<prefix_handler> m_prefix_handlers;
+
+        bool empty() const;
+
+        // The position of the child for a component, or of where it would
+        // be inserted.
+        std::size_t lower_bound(const char* component, std::size_t size) const;
+
+        // Determines whether the child at a position is the one for a
+        // component.
+        bool is_child(std::size_t index, const char* component, std::size_t size) const;
+    };
+
+    struct registration
+    {
+        std::vector<std::string> m_path;
+        bool m_prefix;
+    };
+
+    static std::vector<std::string> split(const std::string& uri);
+
+    // Dispatches the components of the topic from the given offset on, or
+    // to the handlers at the current node once the offset is npos.
+    void dispatch(const node& current, const std::string& uri, std::size_t offset,
+            const wamp_event& event, std::size_t& called, std::exception_ptr& error) const;
+
+    static void call(const wamp_event_handler& handler, const wamp_event& event,
+            std::size_t& called, std::exception_ptr& error);
+
+    bool remove(node& current, const registration& entry, std::size_t depth, std::size_t handle);
+
+private:
+    node m_root;
+    std::map<std::size_t, registration> m_registrations;
+    std::size_t m_next_handle;
+};
+
+} // namespace autobahn
+
+#include "wamp_topic_trie.ipp"
+
+#endif // AUTOBAHN_WAMP_TOPIC_TRIE_HPP
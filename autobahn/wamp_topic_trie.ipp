@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+// Copyright (c) Crossbar.io Technologies GmbH and contributors
+//
+// Boost Software License - Version 1.0 - August 17th, 2003
+//
+// Permission is hereby granted, free of charge, to any person or organization
+// obtaining a copy of the software and accompanying documentation covered by
+// this license (the "Software") to use, reproduce, display, distribute,
+// execute, and transmit the Software, and to prepare derivative works of the
+// Software, and to permit third-parties to whom the Software is furnished to
+// do so, all subject to the following:
+//
+// The copyright notices in the Software and this entire statement, including
+// the above license grant, this restriction and the following disclaimer,
+// must be included in all copies of the Software, in whole or in part, and
+// all derivative works of the Software, unless such copies or derivative
+// works are solely in the form of machine-executable object code generated by
+// a source language processor.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT
+// SHALL THE COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE
+// FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN CONTRACT, TORT OR OTHERWISE,
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+// DEALINGS IN THE SOFTWARE.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <utility>
+
+namespace autobahn {
+
+inline wamp_topic_trie::wamp_topic_trie()
+    : m_root()
+    , m_registrations()
+    , m_next_handle(1)
+{
+}
+
+inline std::size_t wamp_topic_trie::add(
+        const std::string& pattern,
+        const wamp_event_handler& handler,
+        const std::string& match)
+{
+    registration entry;
+    entry.m_path = split(pattern);
+    entry.m_prefix = false;
+
+    std::string tail;
+    if (match == "prefix") {
+        tail = std::move(entry.m_path.back());
+        entry.m_path.pop_back();
+        entry.m_prefix = true;
+    } else if (match == "exact") {
+        for (const auto& component : entry.m_path) {
+            if (component.empty()) {
+                throw std::invalid_argument("an exact pattern must not have empty components");
+            }
+        }
+    } else if (match != "wildcard") {
+        throw std::invalid_argument("The value of 'match' must be 'exact', 'prefix', or 'wildcard'.");
+    }
+
+    node* current = &m_root;
+    for (const auto& component : entry.m_path) {
+        std::size_t index = current->lower_bound(component.data(), component.size());
+        if (!current->is_child(index, component.data(), component.size())) {
+            current->m_children.emplace(current->m_children.begin() + index,
+                    component, std::unique_ptr<node>(new node()));
+        }
+        current = current->m_children[index].second.get();
+    }
+
+    std::size_t handle = m_next_handle++;
+    if (entry.m_prefix) {
+        prefix_handler prefix;
+        prefix.m_handle = handle;
+        prefix.m_tail = std::move(tail);
+        prefix.m_handler = handler;
+        current->m_prefix_handlers.push_back(std::move(prefix));
+    } else {
+        current->m_handlers.emplace_back(handle, handler);
+    }
+
+    m_registrations.emplace(handle, std::move(entry));
+    return handle;
+}
+
+inline bool wamp_topic_trie::remove(std::size_t handle)
+{
+    auto registration_itr = m_registrations.find(handle);
+    if (registration_itr == m_registrations.end()) {
+        return false;
+    }
+
+    remove(m_root, registration_itr->second, 0, handle);
+    m_registrations.erase(registration_itr);
+    return true;
+}
+
+inline std::size_t wamp_topic_trie::dispatch(const wamp_event& event) const
+{
+    std::size_t called = 0;
+    std::exception_ptr error;
+    dispatch(m_root, event->uri(), 0, event, called, error);
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    return called;
+}
+
+inline std::size_t wamp_topic_trie::size() const
+{
+    return m_registrations.size();
+}
+
+inline bool wamp_topic_trie::empty() const
+{
+    return m_registrations.empty();
+}
+
+inline bool wamp_topic_trie::node::empty() const
+{
+    return m_children.empty() && m_handlers.empty() && m_prefix_handlers.empty();
+}
+
+inline std::size_t wamp_topic_trie::node::lower_bound(const char* component, std::size_t size) const
+{
+    std::size_t first = 0;
+    std::size_t count = m_children.size();
+    while (count > 0) {
+        std::size_t step = count / 2;
+        if (m_children[first + step].first.compare(0, std::string::npos, component, size) < 0) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+
+    return first;
+}
+
+inline bool wamp_topic_trie::node::is_child(std::size_t index, const char* component, std::size_t size) const
+{
+    return index < m_children.size()
+            && m_children[index].first.compare(0, std::string::npos, component, size) == 0;
+}
+
+inline std::vector<std::string> wamp_topic_trie::split(const std::string& uri)
+{
+    std::vector<std::string> components;
+
+    std::size_t start = 0;
+    for (;;) {
+        std::size_t end = uri.find('.', start);
+        if (end == std::string::npos) {
+            components.push_back(uri.substr(start));
+            break;
+        }
+
+        components.push_back(uri.substr(start, end - start));
+        start = end + 1;
+    }
+
+    return components;
+}
+
+inline void wamp_topic_trie::dispatch(const node& current, const std::string& uri, std::size_t offset,
+        const wamp_event& event, std::size_t& called, std::exception_ptr& error) const
+{
+    if (offset == std::string::npos) {
+        for (const auto& handler : current.m_handlers) {
+            call(handler.second, event, called, error);
+        }
+        return;
+    }
+
+    std::size_t rest = uri.size() - offset;
+    for (const auto& prefix : current.m_prefix_handlers) {
+        if (prefix.m_tail.size() <= rest
+                && uri.compare(offset, prefix.m_tail.size(), prefix.m_tail) == 0) {
+            call(prefix.m_handler, event, called, error);
+        }
+    }
+
+    std::size_t end = uri.find('.', offset);
+    std::size_t next = end == std::string::npos ? std::string::npos : end + 1;
+    std::size_t size = (end == std::string::npos ? uri.size() : end) - offset;
+
+    std::size_t index = current.lower_bound(uri.data() + offset, size);
+    if (current.is_child(index, uri.data() + offset, size)) {
+        dispatch(*current.m_children[index].second, uri, next, event, called, error);
+    }
+
+    // The empty component of a wildcard pattern matches any component.
+    if (size != 0 && current.is_child(0, uri.data(), 0)) {
+        dispatch(*current.m_children.front().second, uri, next, event, called, error);
+    }
+}
+
+inline void wamp_topic_trie::call(const wamp_event_handler& handler, const wamp_event& event,
+        std::size_t& called, std::exception_ptr& error)
+{
+    ++called;
+
+    try {
+        handler(event);
+    } catch (...) {
+        // One failing handler mustn't keep the event from the others.
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+}
+
+inline bool wamp_topic_trie::remove(
+        node& current, const registration& entry, std::size_t depth, std::size_t handle)
+{
+    if (depth == entry.m_path.size()) {
+        if (entry.m_prefix) {
+            for (auto itr = current.m_prefix_handlers.begin(); itr != current.m_prefix_handlers.end(); ++itr) {
+                if (itr->m_handle == handle) {
+                    current.m_prefix_handlers.erase(itr);
+                    break;
+                }
+            }
+        } else {
+            for (auto itr = current.m_handlers.begin(); itr != current.m_handlers.end(); ++itr) {
+                if (itr->first == handle) {
+                    current.m_handlers.erase(itr);
+                    break;
+                }
+            }
+        }
+        return current.empty();
+    }
+
+    const std::string& component = entry.m_path[depth];
+    std::size_t index = current.lower_bound(component.data(), component.size());
+    if (current.is_child(index, component.data(), component.size())
+            && remove(*current.m_children[index].second, entry, depth + 1, handle)) {
+        // Prune branches that no longer lead to any handler.
+        current.m_children.erase(current.m_children.begin() + index);
+    }
+
+    return current.empty();
+}
+
+} // namespace autobahn
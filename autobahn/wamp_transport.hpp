@@ -32,19 +32,28 @@
 #define AUTOBAHN_WAMP_TRANSPORT_HPP
 
 #include "boost_config.hpp"
+#include "wamp_message.hpp"
+#include "wamp_strand.hpp"
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace autobahn {
 
-class wamp_message;
+class wamp_buffer_pool;
 class wamp_transport_handler;
 
 /*!
  * Provides an abstraction for a transport to be used by the session. A wamp
  * transport is defined as being message based, bidirectional, reliable, and
  * ordered.
+ *
+ * A transport runs all of its completion handlers, including the calls into
+ * the attached handler, on its strand. The session attached to it adopts the
+ * same strand, so that the io service can be run by several threads without
+ * the transport or the session being entered concurrently.
  */
 class wamp_transport
 {
@@ -91,16 +100,40 @@ public:
      */
     virtual bool is_connected() const = 0;
 
+    /*!
+     * The strand that the transport runs its completion handlers on. The
+     * sender and receiver interfaces must only be used from this strand.
+     *
+     * @return The transport's strand.
+     */
+    virtual wamp_strand strand() const = 0;
+
     /*
      * SENDER INTERFACE
      */
     /*!
-     * Send the message synchronously over the transport.
+     * Send the message over the transport. The transport may queue the
+     * message and write it asynchronously, so returning from this call does
+     * not mean the message has reached the remote peer.
      *
      * @param message The message to be sent.
      */
     virtual void send_message(wamp_message&& message) = 0;
 
+    /*!
+     * Send several messages over the transport in order. Transports that
+     * can should hand them to the network in a single write rather than
+     * one write per message. By default each message is sent in turn.
+     *
+     * @param messages The messages to be sent.
+     */
+    virtual void send_messages(std::vector<wamp_message>&& messages)
+    {
+        for (auto& message : messages) {
+            send_message(std::move(message));
+        }
+    }
+
     /*!
      * Set the handler to be invoked when the transport detects congestion
      * sending to the remote peer and needs to apply backpressure on the
@@ -119,6 +152,30 @@ public:
      */
     virtual void set_resume_handler(resume_handler&& handler) = 0;
 
+    /*!
+     * @return The handler currently invoked when sending is paused, so that
+     *         a new one can chain to it.
+     */
+    virtual pause_handler get_pause_handler() const = 0;
+
+    /*!
+     * @return The handler currently invoked when sending is resumed, so that
+     *         a new one can chain to it.
+     */
+    virtual resume_handler get_resume_handler() const = 0;
+
+    /*!
+     * The pool that buffers for outbound messages should be borrowed from,
+     * so that the transport can reuse them once they have been written.
+     *
+     * @return The buffer pool, or null if the transport does not pool its
+     *         buffers.
+     */
+    virtual std::shared_ptr<wamp_buffer_pool> buffer_pool() const
+    {
+        return nullptr;
+    }
+
     /*
      * RECEIVER INTERFACE
      */
@@ -145,7 +202,9 @@ public:
             const std::shared_ptr<wamp_transport_handler>& handler) = 0;
 
     /*!
-     * Detaches the handler currently attached to the transport.
+     * Detaches the handler currently attached to the transport. The handler
+     * is detached on the transport's strand, so when called from outside it
+     * the detach may still be pending when this returns.
      */
     virtual void detach() = 0;
 
@@ -32,12 +32,16 @@
 #define AUTOBAHN_WEBSOCKET_TRANSPORT_HPP
 
 #include "boost_config.hpp"
+#include "wamp_batch_options.hpp"
+#include "wamp_batch_statistics.hpp"
+#include "wamp_buffer_pool.hpp"
 #include "wamp_transport.hpp"
 
 #include <boost/asio/io_service.hpp>
 #include <cstddef>
 #include <memory>
 #include <msgpack.hpp>
+#include <vector>
 
 namespace autobahn {
 
@@ -93,6 +97,34 @@ namespace autobahn {
         */
         virtual void send_message(wamp_message&& message) override;
 
+        /*!
+        * Sends the messages, each as its own websocket message, flushing
+        * anything already held for batching along with them.
+        *
+        * @param messages The messages to be sent.
+        */
+        virtual void send_messages(std::vector<wamp_message>&& messages) override;
+
+        /*!
+        * Sets the options used to coalesce outbound messages. Each WAMP
+        * message is still sent as its own websocket message, but a batch is
+        * handed to the websocket implementation in one go so that it can
+        * write the frames out together.
+        *
+        * @param options The batching options.
+        */
+        void set_batch_options(const wamp_batch_options& options);
+
+        /*!
+        * @return The options used to coalesce outbound messages.
+        */
+        const wamp_batch_options& batch_options() const;
+
+        /*!
+        * @return Counters for the batches handed to the websocket implementation.
+        */
+        const wamp_batch_statistics& batch_statistics() const;
+
         /*!
         * @copydoc wamp_transport::set_pause_handler()
         */
@@ -103,13 +135,29 @@ namespace autobahn {
         */
         virtual void set_resume_handler(resume_handler&& handler) override;
 
+        /*!
+        * @copydoc wamp_transport::get_pause_handler()
+        */
+        virtual pause_handler get_pause_handler() const override;
+
+        /*!
+        * @copydoc wamp_transport::get_resume_handler()
+        */
+        virtual resume_handler get_resume_handler() const override;
+
+        /*!
+        * @copydoc wamp_transport::buffer_pool()
+        */
+        virtual std::shared_ptr<wamp_buffer_pool> buffer_pool() const override;
+
         /*
         * RECEIVER INTERFACE
         */
         /*!
         * Pause receiving of messages. This will prevent the transport from receiving
         * any more messages until it has been resumed. This is used to excert
-        * backpressure on the sending peer.
+        * backpressure on the sending peer. The websocket implementation is
+        * asked to stop reading from its connection, see pause_reading().
         */
         virtual void pause() override;
 
@@ -119,6 +167,23 @@ namespace autobahn {
         */
         virtual void resume() override;
 
+        /*!
+        * Sets the outbound watermarks. Once the number of octets queued for
+        * sending reaches the high watermark the pause handler is invoked. The
+        * resume handler is invoked once the queue has drained down to the low
+        * watermark.
+        *
+        * @param low_watermark The queue size at which sending may resume.
+        * @param high_watermark The queue size at which sending should pause.
+        */
+        void set_send_watermarks(std::size_t low_watermark, std::size_t high_watermark);
+
+        /*!
+        * @return The number of octets queued for sending, both those held for
+        *         batching and those buffered by the websocket implementation.
+        */
+        std::size_t queued_bytes() const;
+
         /*!
         * @copydoc wamp_transport::attach()
         */
@@ -145,8 +210,61 @@ namespace autobahn {
 
         virtual void write(void const * payload, size_t len) = 0;
 
+        /*!
+        * Arranges for flush_messages() to be called once the batching delay
+        * has elapsed. Implementations that know about their event loop should
+        * override this; by default the batch is flushed straight away.
+        *
+        * @param delay How long the batch may be held, zero meaning until
+        *              the next turn of the event loop.
+        */
+        virtual void schedule_flush(const std::chrono::microseconds& delay);
+
+        /*!
+        * Writes out all messages held for batching.
+        */
+        void flush_messages();
+
+        /*!
+        * The number of octets the websocket implementation has accepted but
+        * not yet written. Returns zero by default.
+        */
+        virtual std::size_t buffered_amount() const;
+
+        /*!
+        * Stops reading from the connection. Does nothing by default.
+        */
+        virtual void pause_reading();
+
+        /*!
+        * Starts reading from the connection again. Does nothing by default.
+        */
+        virtual void resume_reading();
+
+        /*!
+        * Called when sending becomes paused. Implementations should keep
+        * calling update_send_backpressure() for as long as is_send_paused()
+        * holds, since websocket implementations don't report when their
+        * buffers have drained. Does nothing by default.
+        */
+        virtual void poll_send_backpressure();
+
+        /*!
+        * Compares the outbound queue against the watermarks and invokes the
+        * pause or resume handler as needed.
+        */
+        void update_send_backpressure();
+
+        /*!
+        * Whether or not the pause handler has been invoked without a matching
+        * call to the resume handler.
+        */
+        bool is_send_paused() const;
+
         void receive_message(const std::string& msg);
 
+        wamp_buffer_ptr serialize(wamp_message&& message);
+
         /*!
         * The promise that is fulfilled when the connect attempt is complete.
         */
@@ -178,6 +296,53 @@ namespace autobahn {
             */
             std::shared_ptr<wamp_transport_handler> m_handler;
 
+            /*!
+            * Pool of buffers for outbound messages. Buffers are returned to
+            * it once they have been handed to the websocket implementation.
+            */
+            std::shared_ptr<wamp_buffer_pool> m_buffer_pool;
+
+            /*!
+            * Serialized messages held for batching.
+            */
+            std::vector<wamp_buffer_ptr> m_send_queue;
+
+            /*!
+            * The number of octets held in the send queue.
+            */
+            std::size_t m_send_queue_bytes;
+
+            /*!
+            * Whether or not a flush of the send queue has been scheduled.
+            */
+            bool m_flush_pending;
+
+            /*!
+            * The queue size at which the resume handler is invoked.
+            */
+            std::size_t m_low_watermark;
+
+            /*!
+            * The queue size at which the pause handler is invoked.
+            */
+            std::size_t m_high_watermark;
+
+            /*!
+            * Whether or not the pause handler has been invoked without a
+            * matching call to the resume handler.
+            */
+            bool m_send_paused;
+
+            /*!
+            * The options used to coalesce outbound messages.
+            */
+            wamp_batch_options m_batch_options;
+
+            /*!
+            * Counters for the batches handed to the websocket implementation.
+            */
+            wamp_batch_statistics m_batch_statistics;
+
             /*!
             * Used for unpacking serialized messages.
             */
@@ -33,6 +33,7 @@
 #include "wamp_transport_handler.hpp"
 
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/dispatch.hpp>
 #include <boost/asio/placeholders.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/write.hpp>
@@ -46,6 +47,15 @@ inline wamp_websocket_transport::wamp_websocket_transport(
     : wamp_transport()
     , m_connect()
     , m_disconnect()
+    , m_buffer_pool(std::make_shared<wamp_buffer_pool>())
+    , m_send_queue()
+    , m_send_queue_bytes(0)
+    , m_flush_pending(false)
+    , m_low_watermark(1024 * 1024)
+    , m_high_watermark(4 * 1024 * 1024)
+    , m_send_paused(false)
+    , m_batch_options()
+    , m_batch_statistics()
     , m_message_unpacker()
     , m_debug_enabled(debug_enabled)
     , m_uri(uri)
@@ -72,6 +82,9 @@ inline boost::future<void> wamp_websocket_transport::disconnect()
 
     close();
 
+    m_send_queue.clear();
+    m_send_queue_bytes = 0;
+
     m_disconnect.set_value();
     return m_disconnect.get_future();
 }
@@ -83,18 +96,109 @@ inline bool wamp_websocket_transport::is_connected() const
 
 inline void wamp_websocket_transport::send_message(wamp_message&& message)
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    packer.pack(message.fields());
+    wamp_buffer_ptr buffer = serialize(std::move(message));
+
+    if (!m_batch_options.enabled()) {
+        // Write actual serialized message.
+        write(buffer->data(), buffer->size());
+        m_batch_statistics.record_batch(1, buffer->size());
+    } else {
+        m_send_queue_bytes += buffer->size();
+        m_send_queue.push_back(std::move(buffer));
+
+        if (m_send_queue_bytes >= m_batch_options.max_bytes()) {
+            flush_messages();
+        } else if (!m_flush_pending) {
+            m_flush_pending = true;
+            schedule_flush(m_batch_options.max_delay());
+        }
+    }
 
+    update_send_backpressure();
+}
 
-    // Write actual serialized message.
-    write(buffer->data(), buffer->size());
+inline void wamp_websocket_transport::send_messages(std::vector<wamp_message>&& messages)
+{
+    for (auto& message : messages) {
+        wamp_buffer_ptr buffer = serialize(std::move(message));
+        m_send_queue_bytes += buffer->size();
+        m_send_queue.push_back(std::move(buffer));
+    }
 
+    // The batch is already as large as the caller wanted it to be, so it
+    // isn't held back for the batching delay.
+    flush_messages();
+
+    update_send_backpressure();
+}
+
+inline wamp_buffer_ptr wamp_websocket_transport::serialize(wamp_message&& message)
+{
     if (m_debug_enabled) {
-        std::cerr << "TX message (" << buffer->size() << " octets) ..." << std::endl;
         std::cerr << "TX message: " << message << std::endl;
     }
+
+    wamp_buffer_ptr buffer;
+    if (message.is_serialized()) {
+        buffer = std::move(message.serialized());
+    } else {
+        buffer = m_buffer_pool->acquire();
+        msgpack::packer<msgpack::sbuffer> packer(*buffer);
+        packer.pack(message.fields());
+    }
+
+    if (m_debug_enabled) {
+        std::cerr << "TX message (" << buffer->size() << " octets) ..." << std::endl;
+    }
+
+    return buffer;
+}
+
+inline void wamp_websocket_transport::set_batch_options(const wamp_batch_options& options)
+{
+    m_batch_options = options;
+
+    // Don't strand anything that was held under the previous options.
+    if (!m_batch_options.enabled()) {
+        flush_messages();
+    }
+}
+
+inline const wamp_batch_options& wamp_websocket_transport::batch_options() const
+{
+    return m_batch_options;
+}
+
+inline const wamp_batch_statistics& wamp_websocket_transport::batch_statistics() const
+{
+    return m_batch_statistics;
+}
+
+inline void wamp_websocket_transport::schedule_flush(const std::chrono::microseconds&)
+{
+    flush_messages();
+}
+
+inline void wamp_websocket_transport::flush_messages()
+{
+    m_flush_pending = false;
+
+    if (m_send_queue.empty()) {
+        return;
+    }
+
+    for (const auto& buffer : m_send_queue) {
+        write(buffer->data(), buffer->size());
+    }
+
+    m_batch_statistics.record_batch(m_send_queue.size(), m_send_queue_bytes);
+    m_send_queue.clear();
+    m_send_queue_bytes = 0;
+}
+
+inline std::shared_ptr<wamp_buffer_pool> wamp_websocket_transport::buffer_pool() const
+{
+    return m_buffer_pool;
 }
 
 inline void wamp_websocket_transport::set_pause_handler(pause_handler&& handler)
@@ -107,18 +211,40 @@ inline void wamp_websocket_transport::set_resume_handler(resume_handler&& handle
     m_resume_handler = std::move(handler);
 }
 
+inline wamp_transport::pause_handler wamp_websocket_transport::get_pause_handler() const
+{
+    return m_pause_handler;
+}
+
+inline wamp_transport::resume_handler wamp_websocket_transport::get_resume_handler() const
+{
+    return m_resume_handler;
+}
+
 inline void wamp_websocket_transport::pause()
 {
-    if (m_pause_handler) {
-        m_pause_handler();
-    }
+    pause_reading();
 }
 
 inline void wamp_websocket_transport::resume()
 {
-    if (m_resume_handler) {
-        m_resume_handler();
+    resume_reading();
+}
+
+inline void wamp_websocket_transport::set_send_watermarks(
+    std::size_t low_watermark, std::size_t high_watermark)
+{
+    if (low_watermark > high_watermark) {
+        throw std::invalid_argument("low watermark must not exceed the high watermark");
     }
+
+    m_low_watermark = low_watermark;
+    m_high_watermark = high_watermark;
+}
+
+inline std::size_t wamp_websocket_transport::queued_bytes() const
+{
+    return m_send_queue_bytes + buffered_amount();
 }
 
 inline void wamp_websocket_transport::attach(
@@ -139,8 +265,15 @@ inline void wamp_websocket_transport::detach()
         throw std::logic_error("no handler attached");
     }
 
-    m_handler->on_detach(true, "wamp.error.goodbye");
-    m_handler.reset();
+    // Handlers are only ever invoked on the strand, so the handler is
+    // detached there too rather than from under a message being delivered.
+    auto shared_self = this->shared_from_this();
+    boost::asio::dispatch(strand(), [shared_self]() {
+        if (shared_self->m_handler) {
+            shared_self->m_handler->on_detach(true, "wamp.error.goodbye");
+            shared_self->m_handler.reset();
+        }
+    });
 }
 
 inline bool wamp_websocket_transport::has_handler() const
@@ -149,6 +282,48 @@ inline bool wamp_websocket_transport::has_handler() const
 }
 
 
+inline std::size_t wamp_websocket_transport::buffered_amount() const
+{
+    return 0;
+}
+
+inline void wamp_websocket_transport::pause_reading()
+{
+}
+
+inline void wamp_websocket_transport::resume_reading()
+{
+}
+
+inline void wamp_websocket_transport::poll_send_backpressure()
+{
+}
+
+inline void wamp_websocket_transport::update_send_backpressure()
+{
+    std::size_t queued = queued_bytes();
+
+    if (!m_send_paused) {
+        if (queued >= m_high_watermark) {
+            m_send_paused = true;
+            if (m_pause_handler) {
+                m_pause_handler();
+            }
+            poll_send_backpressure();
+        }
+    } else if (queued <= m_low_watermark) {
+        m_send_paused = false;
+        if (m_resume_handler) {
+            m_resume_handler();
+        }
+    }
+}
+
+inline bool wamp_websocket_transport::is_send_paused() const
+{
+    return m_send_paused;
+}
+
 inline void wamp_websocket_transport::receive_message(const std::string& msg)
 {
     if (m_debug_enabled) {
@@ -163,10 +338,7 @@ inline void wamp_websocket_transport::receive_message(const std::string& msg)
         msgpack::unpacked result;
 
         while (m_message_unpacker.next(result)) {
-            wamp_message::message_fields fields;
-            result.get().convert(fields);
-
-            wamp_message message(std::move(fields), std::move(*(result.zone())));
+            wamp_message message(result.get(), std::move(result.zone()));
             if (m_debug_enabled) {
                 std::cerr << "RX message: " << message << std::endl;
             }
@@ -74,11 +74,32 @@ namespace autobahn {
 
 		virtual bool is_connected() const override;
 
+        /*!
+        * @copydoc wamp_transport::strand()
+        */
+        virtual wamp_strand strand() const override;
+
     private:
         virtual bool is_open() const override;
         virtual void close() override;
         virtual void async_connect(const std::string& uri, boost::promise<void>& connect_promise) override;
         virtual void write(void const * payload, size_t len) override;
+        virtual void schedule_flush(const std::chrono::microseconds& delay) override;
+        virtual std::size_t buffered_amount() const override;
+        virtual void pause_reading() override;
+        virtual void resume_reading() override;
+        virtual void poll_send_backpressure() override;
+
+        /*!
+        * Checks the send queue again after the given number of milliseconds.
+        */
+        void poll_send_backpressure(long interval);
+
+        /*!
+        * The longest, in milliseconds, between checks of a paused send queue
+        * unless the batching delay is longer.
+        */
+        static const long max_poll_interval = 16;
 
     private:
 
@@ -92,6 +113,11 @@ namespace autobahn {
         */
         client_type &m_client;
 
+        /*!
+        * The strand incoming messages and deferred flushes are handled on.
+        */
+        wamp_strand m_strand;
+
         websocketpp::connection_hdl m_hdl;
         boost::mutex m_lock;
         bool m_open;
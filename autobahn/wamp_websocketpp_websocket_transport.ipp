@@ -30,8 +30,11 @@
 
 #include "wamp_websocket_transport.hpp"
 
+#include <boost/asio/dispatch.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/system/error_code.hpp>
 #include <websocketpp/client.hpp>
+#include <chrono>
 
 namespace autobahn {
 
@@ -42,6 +45,7 @@ namespace autobahn {
         bool debug_enabled)
         : wamp_websocket_transport(uri, debug_enabled)
         , m_client(client)
+        , m_strand(client.get_io_service().get_executor())
         , m_hdl()
         , m_open(false)
         , m_done(false)
@@ -76,6 +80,12 @@ namespace autobahn {
 		return is_open() && !m_done;
 	}
 
+    template <class Config>
+    inline wamp_strand wamp_websocketpp_websocket_transport<Config>::strand() const
+    {
+        return m_strand;
+    }
+
     // The open handler will signal that we are ready to start sending telemetry
     template <class Config>
     inline void wamp_websocketpp_websocket_transport<Config>::on_ws_open(websocketpp::connection_hdl) {
@@ -108,7 +118,15 @@ namespace autobahn {
     template <class Config>
     inline void wamp_websocketpp_websocket_transport<Config>::on_ws_message(websocketpp::connection_hdl, typename client_type::message_ptr msg) {
         if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
-            receive_message(msg->get_payload());
+            // WebSocket++ runs its handlers on the bare io_service, so hop
+            // onto the strand the attached session is using.
+            std::weak_ptr<wamp_websocket_transport> weak_self = shared_from_this();
+            boost::asio::dispatch(m_strand, [=]() {
+                auto shared_self = weak_self.lock();
+                if (shared_self) {
+                    receive_message(msg->get_payload());
+                }
+            });
         }
         else {
             //m_messages.push_back("<< " + websocketpp::utility::to_hex(msg->get_payload()));
@@ -145,6 +163,111 @@ namespace autobahn {
         m_client.send(m_hdl, payload, len, websocketpp::frame::opcode::binary, ec);
     }
 
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::schedule_flush(const std::chrono::microseconds& delay)
+    {
+        std::weak_ptr<wamp_websocket_transport> weak_self = shared_from_this();
+
+        if (delay == std::chrono::microseconds::zero()) {
+            boost::asio::post(m_strand, [=]() {
+                auto shared_self = weak_self.lock();
+                if (shared_self) {
+                    flush_messages();
+                }
+            });
+            return;
+        }
+
+        // WebSocket++ timers have millisecond resolution, so round up rather
+        // than flushing early.
+        auto delay_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                delay + std::chrono::microseconds(999));
+        m_client.set_timer(static_cast<long>(delay_ms.count()), [=](const websocketpp::lib::error_code& ec) {
+            if (ec) {
+                return;
+            }
+
+            boost::asio::dispatch(m_strand, [=]() {
+                auto shared_self = weak_self.lock();
+                if (shared_self) {
+                    flush_messages();
+                }
+            });
+        });
+    }
+
+    template <class Config>
+    inline std::size_t wamp_websocketpp_websocket_transport<Config>::buffered_amount() const
+    {
+        websocketpp::lib::error_code ec;
+        auto con = m_client.get_con_from_hdl(m_hdl, ec);
+        if (ec) {
+            return 0;
+        }
+
+        return con->get_buffered_amount();
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::pause_reading()
+    {
+        websocketpp::lib::error_code ec;
+        auto con = m_client.get_con_from_hdl(m_hdl, ec);
+        if (!ec) {
+            con->pause_reading();
+        }
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::resume_reading()
+    {
+        websocketpp::lib::error_code ec;
+        auto con = m_client.get_con_from_hdl(m_hdl, ec);
+        if (!ec) {
+            con->resume_reading();
+        }
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::poll_send_backpressure()
+    {
+        poll_send_backpressure(1);
+    }
+
+    template <class Config>
+    inline void wamp_websocketpp_websocket_transport<Config>::poll_send_backpressure(long interval)
+    {
+        std::weak_ptr<wamp_websocket_transport> weak_self = shared_from_this();
+
+        // WebSocket++ has no notification for its send queue draining, so
+        // check again after a while. The interval doubles for as long as
+        // sending stays paused, up to max_poll_interval or the batching
+        // delay if that is longer, so that a stalled peer doesn't keep
+        // waking up the io service.
+        long max_interval = static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                batch_options().max_delay()).count());
+        if (max_interval < max_poll_interval) {
+            max_interval = max_poll_interval;
+        }
+        long next_interval = interval * 2 < max_interval ? interval * 2 : max_interval;
+
+        m_client.set_timer(interval, [=](const websocketpp::lib::error_code& ec) {
+            if (ec) {
+                return;
+            }
+
+            boost::asio::dispatch(m_strand, [=]() {
+                auto shared_self = weak_self.lock();
+                if (shared_self) {
+                    update_send_backpressure();
+                    if (is_send_paused()) {
+                        poll_send_backpressure(next_interval);
+                    }
+                }
+            });
+        });
+    }
+
     template <class Config>
     inline void wamp_websocketpp_websocket_transport<Config>::close()
     {